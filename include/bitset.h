@@ -0,0 +1,54 @@
+#ifndef ED_BITSET_GUARD_HEADER
+#define ED_BITSET_GUARD_HEADER
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * Represents the length of bits that a word of a bitset has.
+ */
+#define BITSET_WORD_BITS 64
+
+/**
+ * Return the length of words that are needed to store bits.
+ *
+ * @param len the length of bits
+ * @return the length of words
+ */
+static inline size_t bitset_words(size_t len) {
+    return (len + BITSET_WORD_BITS - 1) / BITSET_WORD_BITS;
+}
+
+/**
+ * Check if a bit is set.
+ *
+ * @param bits the bitset to check
+ * @param k the bit position
+ * @return true if it's set, otherwise false
+ */
+static inline bool bitset_get(const uint64_t* bits, size_t k) {
+    return (bits[k / BITSET_WORD_BITS] >> (k % BITSET_WORD_BITS)) & 1;
+}
+
+/**
+ * Set a bit.
+ *
+ * @param bits the bitset where to set the bit
+ * @param k the bit position
+ */
+static inline void bitset_set(uint64_t* bits, size_t k) {
+    bits[k / BITSET_WORD_BITS] |= (uint64_t) 1 << (k % BITSET_WORD_BITS);
+}
+
+/**
+ * Clear a bit.
+ *
+ * @param bits the bitset where to clear the bit
+ * @param k the bit position
+ */
+static inline void bitset_clear(uint64_t* bits, size_t k) {
+    bits[k / BITSET_WORD_BITS] &= ~((uint64_t) 1 << (k % BITSET_WORD_BITS));
+}
+
+#endif // ED_BITSET_GUARD_HEADER
@@ -0,0 +1,133 @@
+#ifndef ED_CH_GUARD_HEADER
+#define ED_CH_GUARD_HEADER
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "vertex.h"
+#include "weight.h"
+#include "path.h"
+#include "heap.h"
+
+struct graph;
+
+/**
+ * Represents the length of vertices that a witness search can
+ * settle while a vertex is contracted, if it can't prove that
+ * a shortcut is redundant in that length then the shortcut is
+ * added anyway.
+ */
+#define GCH_WITNESS_SETTLED 128
+
+/**
+ * Represents an edge to a vertex of higher rank in a
+ * contraction hierarchy.
+ *
+ * @member vertex the vertex of higher rank
+ * @member middle the contracted vertex that the edge skips
+ *                (a shortcut), VERTEX_T_MAX if it's an edge of
+ *                the graph
+ * @member weight the edge's weight, it's a distance_t since a
+ *                shortcut adds up several weights
+ */
+struct gch_arc {
+    vertex_t vertex;
+    vertex_t middle;
+    distance_t weight;
+};
+
+/**
+ * Represents a contraction hierarchy (CH) of a graph.
+ *
+ * Every vertex has a rank given by the order in which it was
+ * contracted, and it keeps just the edges to vertices of higher
+ * rank. A weakest path always goes up and then down through the
+ * ranks, so a query is a bidirectional search that just goes up
+ * and it settles a few vertices.
+ *
+ * The query buffers are kept in the hierarchy and just the
+ * touched vertices are reset, so a query doesn't take O(V)
+ * time, but the same hierarchy can't be queried by several
+ * threads at once.
+ *
+ * @see gch_init
+ * @see gch_destroy
+ *
+ * @member len the length of vertices
+ * @member ranks the rank of each vertex
+ * @member offsets where the arcs of each vertex start at, it has
+ *                 len + 1 elements
+ * @member arcs the arcs of all vertices, each run sorted by the
+ *              vertex of higher rank
+ * @member distances the distance of each vertex in the forward
+ *                   and the backward searches of a query
+ * @member parents the vertex that precedes each vertex in the
+ *                 forward and the backward searches of a query
+ * @member heaps the queues of the forward and the backward
+ *               searches of a query
+ * @member touched the vertices whose distance was set in a
+ *                 query
+ * @member touched_len the length of touched vertices
+ */
+struct gch {
+    size_t len;
+    vertex_t* ranks;
+
+    size_t* offsets;
+    struct gch_arc* arcs;
+
+    distance_t* distances[2];
+    vertex_t* parents[2];
+    struct heap_vertex heaps[2];
+    vertex_t* touched;
+    size_t touched_len;
+};
+
+/**
+ * Build a contraction hierarchy of a graph.
+ *
+ * The vertices are contracted by importance (the edge
+ * difference plus the contracted neighbors), and the importance
+ * is updated lazily when a vertex is about to be contracted. A
+ * shortcut is added just if a bounded witness search can't find
+ * a path as weak without the contracted vertex.
+ *
+ * The weights must not be negative, and the hierarchy doesn't
+ * follow the graph when it's modified.
+ *
+ * @param ch the hierarchy to build
+ * @param graph the graph to build from
+ * @return true if it could build the hierarchy, otherwise false
+ */
+bool gch_init(struct gch* ch, struct graph* graph);
+/**
+ * Destroy an initialized hierarchy.
+ *
+ * @param ch the hierarchy to destroy
+ */
+void gch_destroy(struct gch* ch);
+
+/**
+ * Return the weight of the weakest path between two vertices.
+ *
+ * @param ch the hierarchy to query
+ * @param start_vertex the source vertex
+ * @param end_vertex the destination vertex
+ * @return the weight, DISTANCE_MAX if there is no path
+ */
+distance_t gch_distance(struct gch* ch, vertex_t start_vertex, vertex_t end_vertex);
+/**
+ * Find the weakest path between two vertices, the shortcuts are
+ * unpacked into the edges of the graph.
+ *
+ * @param ch the hierarchy to query
+ * @param start_vertex the source vertex
+ * @param end_vertex the destination vertex
+ * @param out_path where it'll store the path, it must be
+ *                 initialized
+ * @return true if there is a path, otherwise false
+ */
+bool gch_path(struct gch* ch, vertex_t start_vertex, vertex_t end_vertex, struct path* out_path);
+
+#endif // ED_CH_GUARD_HEADER
@@ -0,0 +1,140 @@
+#ifndef ED_CSR_GUARD_HEADER
+#define ED_CSR_GUARD_HEADER
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "vertex.h"
+
+/**
+ * Represents the adjacency of a graph in a compressed sparse
+ * row (CSR) layout.
+ *
+ * The neighbors of a vertex vi are stored in the interval
+ * [offsets[vi], offsets[vi + 1]) of neighbors and weights,
+ * sorted in ascending order by the neighbor vertex.
+ *
+ * @see gcsr_init
+ * @see gcsr_destroy
+ *
+ * @member len the length of vertices that there are in
+ * @member reserved the length of vertices that offsets can hold
+ * @member capacity the reserved space of neighbors and weights
+ * @member offsets where the neighbors of each vertex start at,
+ *                 it has len + 1 elements
+ * @member neighbors the neighbor vertices of all vertices
+ * @member weights the edge's weight of each neighbor
+ */
+struct gcsr {
+    size_t len;
+    size_t reserved;
+    size_t capacity;
+
+    size_t* offsets;
+    vertex_t* neighbors;
+    weight_t* weights;
+};
+
+/**
+ * Initialize a CSR adjacency from an edge list.
+ *
+ * The edges are treated as undirected and they are applied
+ * in the same order that graph_addw would do, so if an edge
+ * is repeated, the last one is the one that remains. Edges
+ * with the empty weight of the graph are treated as removals
+ * and edges with out of range vertices are ignored.
+ *
+ * It takes O(V + E log E) time.
+ *
+ * @param csr the adjacency to initialize
+ * @param weighted if the graph is weighted
+ * @param len the length of vertices that there will be
+ * @param edges the edge list to build from, it can be NULL
+ * @param edge_len the length of edges
+ */
+void gcsr_init(struct gcsr* csr,
+               bool weighted,
+               size_t len,
+               const struct edge* edges,
+               size_t edge_len);
+/**
+ * Destroy an initialized CSR adjacency.
+ *
+ * @param csr the adjacency to destroy
+ */
+void gcsr_destroy(struct gcsr* csr);
+
+/**
+ * Reserve space for more vertices.
+ *
+ * If the reserved space is already enough, then it'll not
+ * apply any action.
+ *
+ * @param csr the adjacency to reserve space
+ * @param reserved the length of vertices to hold
+ * @return true if there is enough space, otherwise false
+ */
+bool gcsr_reserve(struct gcsr* csr, size_t reserved);
+/**
+ * Add a vertex without neighbors at the end of the adjacency.
+ *
+ * It takes O(1) time if there is reserved space for it.
+ *
+ * @see gcsr_reserve
+ *
+ * @param csr the adjacency where to add the vertex
+ * @return the added vertex, VERTEX_T_MAX if it couldn't
+ */
+vertex_t gcsr_add_vertex(struct gcsr* csr);
+
+/**
+ * Look for the position of a neighbor wj in the run of vi
+ * by a binary search.
+ *
+ * @param csr the adjacency where to look for
+ * @param vi the source vertex
+ * @param wj the destination vertex
+ * @param out_pos the position where wj is, or where it would
+ *                be inserted if it is not
+ * @return true if wj is a neighbor of vi, otherwise false
+ */
+bool gcsr_find(const struct gcsr* csr, vertex_t vi, vertex_t wj, size_t* out_pos);
+/**
+ * Set the weight of the edge <vi, wj> (just in one direction).
+ *
+ * If the edge doesn't exist then it's inserted, which takes
+ * O(V + E) time since the following runs must be shifted.
+ *
+ * @param csr the adjacency where to set the edge
+ * @param vi the source vertex
+ * @param wj the destination vertex
+ * @param weight the edge's weight
+ * @return true if the edge is set, false if there is no memory
+ *         to insert it
+ */
+bool gcsr_set(struct gcsr* csr, vertex_t vi, vertex_t wj, weight_t weight);
+/**
+ * Remove the edge <vi, wj> (just in one direction).
+ *
+ * It takes O(V + E) time since the following runs must be
+ * shifted.
+ *
+ * @param csr the adjacency where to remove the edge
+ * @param vi the source vertex
+ * @param wj the destination vertex
+ */
+void gcsr_del(struct gcsr* csr, vertex_t vi, vertex_t wj);
+
+/**
+ * Return the size of neighbors that a vertex has.
+ *
+ * @param csr the adjacency to look for
+ * @param vi the vertex
+ * @return the vertex's degree
+ */
+static inline size_t gcsr_degree(const struct gcsr* csr, vertex_t vi) {
+    return csr->offsets[vi + 1] - csr->offsets[vi];
+}
+
+#endif // ED_CSR_GUARD_HEADER
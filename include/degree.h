@@ -0,0 +1,132 @@
+#ifndef ED_DEGREE_GUARD_HEADER
+#define ED_DEGREE_GUARD_HEADER
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "vertex.h"
+
+/**
+ * Represents the degrees of the vertices of a graph, bucketed
+ * by degree.
+ *
+ * The vertices are kept in order sorted by degree, where the
+ * vertices with degree d are in the interval
+ * [starts[d], starts[d + 1]), so a degree changes by one just
+ * swapping a vertex with the boundary of its bucket. It gives
+ * the histogram, the minimal and the maximal degree in O(1).
+ *
+ * @see gdegree_init
+ * @see gdegree_destroy
+ *
+ * @member len the length of vertices that there are in
+ * @member capacity the length of vertices that it can hold
+ * @member top the greatest degree that the buckets cover, it's
+ *             never lower than the maximal degree and starts
+ *             is valid until starts[top + 1]
+ * @member degrees the degree of each vertex
+ * @member order the vertices sorted by degree
+ * @member positions where each vertex is in order
+ * @member starts where the bucket of each degree starts in order
+ */
+struct gdegree {
+    size_t len;
+    size_t capacity;
+    size_t top;
+
+    size_t* degrees;
+    vertex_t* order;
+    size_t* positions;
+    size_t* starts;
+};
+
+/**
+ * Initialize the degrees from a given degree of each vertex.
+ *
+ * It takes O(V) time since the buckets are built by counting.
+ *
+ * @param degree the degrees to initialize
+ * @param len the length of vertices
+ * @param degrees the degree of each vertex, NULL if all of
+ *                them are 0
+ */
+void gdegree_init(struct gdegree* degree, size_t len, const size_t* degrees);
+/**
+ * Destroy initialized degrees.
+ *
+ * @param degree the degrees to destroy
+ */
+void gdegree_destroy(struct gdegree* degree);
+
+/**
+ * Reserve space for more vertices.
+ *
+ * @param degree the degrees to reserve space
+ * @param capacity the length of vertices to hold
+ * @return true if there is enough space, otherwise false
+ */
+bool gdegree_reserve(struct gdegree* degree, size_t capacity);
+/**
+ * Add a vertex with degree 0 at the end.
+ *
+ * It takes O(top) time since every bucket is shifted by one.
+ *
+ * @param degree the degrees where to add the vertex
+ */
+void gdegree_add_vertex(struct gdegree* degree);
+/**
+ * Increase the degree of a vertex by one in O(1).
+ *
+ * @param degree the degrees where the vertex is
+ * @param vi the vertex
+ */
+void gdegree_inc(struct gdegree* degree, vertex_t vi);
+/**
+ * Decrease the degree of a vertex by one in O(1).
+ *
+ * @param degree the degrees where the vertex is
+ * @param vi the vertex, its degree must not be 0
+ */
+void gdegree_dec(struct gdegree* degree, vertex_t vi);
+
+/**
+ * Return the minimal degree, 0 if there is no vertex.
+ *
+ * @param degree the degrees to look for
+ * @return the minimal degree
+ */
+static inline size_t gdegree_min(const struct gdegree* degree) {
+    return degree->len > 0 ? degree->degrees[degree->order[0]] : 0;
+}
+
+/**
+ * Return the maximal degree, 0 if there is no vertex.
+ *
+ * @param degree the degrees to look for
+ * @return the maximal degree
+ */
+static inline size_t gdegree_max(const struct gdegree* degree) {
+    return degree->len > 0 ? degree->degrees[degree->order[degree->len - 1]] : 0;
+}
+
+/**
+ * Return the vertices that have a given degree.
+ *
+ * @param degree the degrees to look for
+ * @param d the degree
+ * @param out_len where it'll store the length of vertices
+ * @return the vertices of the bucket, they're valid until the
+ *         degrees are modified
+ */
+static inline const vertex_t* gdegree_bucket(const struct gdegree* degree, size_t d, size_t* out_len) {
+    if (degree->len == 0 || d > degree->top) {
+        *out_len = 0;
+        return NULL;
+    }
+
+    *out_len = degree->starts[d + 1] - degree->starts[d];
+    return &degree->order[degree->starts[d]];
+}
+
+#endif // ED_DEGREE_GUARD_HEADER
@@ -9,14 +9,145 @@
 #include "map.h"
 
 #include "vertex.h"
+#include "weight.h"
 #include "wave.h"
 #include "path.h"
+#include "csr.h"
+#include "degree.h"
 
 /**
- * Represents the value that indicates that there is no edge
- * between two vertices.
+ * Represents the different layouts that a graph can use to
+ * store its edges.
+ *
+ * @member GRAPH_STORAGE_MATRIX a dense adjacency matrix, it
+ *                              takes O(V^2) space and O(1)
+ *                              edge lookups
+ * @member GRAPH_STORAGE_CSR a compressed sparse row layout, it
+ *                           takes O(V + E) space and
+ *                           O(log deg) edge lookups
+ * @member GRAPH_STORAGE_BITSET a dense adjacency matrix of bits,
+ *                              it takes 1/32 of the space of
+ *                              GRAPH_STORAGE_MATRIX but it's
+ *                              just for unweighted graphs
+ * @member GRAPH_STORAGE_TRIANGLE a packed upper triangle of the
+ *                                adjacency matrix, it takes half
+ *                                of the space of
+ *                                GRAPH_STORAGE_MATRIX and every
+ *                                edge is written just once
+ * @member GRAPH_STORAGE_INDEXED a dense adjacency matrix with a
+ *                               list of neighbors per vertex,
+ *                               it keeps the O(1) edge lookups
+ *                               and iterates just the neighbors
+ *                               instead of scanning rows, but it
+ *                               takes the space of
+ *                               GRAPH_STORAGE_MATRIX plus 2V^2
+ *                               vertices
+ * @member GRAPH_STORAGE_CUSTOM a layout that is not built in,
+ *                             it's given by graph_init_ops
+ * @member GRAPH_STORAGE_AUTO picks one of the above ones from
+ *                           the density of the graph
+ *
+ * @see graph_pick_storage
+ */
+enum graph_storage {
+    GRAPH_STORAGE_MATRIX,
+    GRAPH_STORAGE_CSR,
+    GRAPH_STORAGE_BITSET,
+    GRAPH_STORAGE_TRIANGLE,
+    GRAPH_STORAGE_INDEXED,
+    GRAPH_STORAGE_CUSTOM,
+    GRAPH_STORAGE_AUTO
+};
+
+/**
+ * Represents the minimal density (2E / V^2) that a weighted
+ * graph must have to be stored in GRAPH_STORAGE_MATRIX when
+ * the storage is picked automatically.
+ *
+ * A CSR entry takes 3 times the space of a matrix cell and
+ * every edge is stored twice, so below it the CSR is smaller
+ * and its neighbor runs are shorter than scanning rows.
+ */
+#define GRAPH_AUTO_MATRIX_DENSITY 0.25
+/**
+ * Represents the minimal density (2E / V^2) that an unweighted
+ * graph must have to be stored in GRAPH_STORAGE_BITSET when
+ * the storage is picked automatically.
+ *
+ * A word of a row holds 64 vertices, so below a neighbor for
+ * every 64 vertices the CSR is both smaller and faster.
+ */
+#define GRAPH_AUTO_BITSET_DENSITY (1.0 / 64)
+
+/**
+ * Represents the different searches that graph_minimal_path_mode
+ * can use to find the weakest paths.
+ *
+ * @member GRAPH_PATH_DIJKSTRA a single search from the source
+ *                            vertex, it finds the paths to all
+ *                            the settled vertices
+ * @member GRAPH_PATH_BIDIRECTIONAL a search from both vertices
+ *                                 that stops when they meet, it
+ *                                 finds just the path to the
+ *                                 destination vertex
+ * @member GRAPH_PATH_ALT a search directed to the destination
+ *                       vertex (A*) whose lower bounds come from
+ *                       the distances to some landmarks, it
+ *                       finds just the path to the destination
+ *                       vertex
+ * @member GRAPH_PATH_DELTA_STEPPING a search of buckets whose
+ *                                  vertices are relaxed in
+ *                                  parallel by all processors,
+ *                                  it finds the same paths such
+ *                                  as GRAPH_PATH_DIJKSTRA
+ */
+enum graph_path_mode {
+    GRAPH_PATH_DIJKSTRA,
+    GRAPH_PATH_BIDIRECTIONAL,
+    GRAPH_PATH_ALT,
+    GRAPH_PATH_DELTA_STEPPING
+};
+
+/**
+ * Represents the length of landmarks that GRAPH_PATH_ALT picks
+ * when there are no landmarks cached in the graph.
+ */
+#define GRAPH_ALT_LANDMARKS 8
+
+/**
+ * Represents the heaviest weight for which graph_sssp queues the
+ * vertices in a bucket queue instead of a heap, it takes a
+ * bucket for each weight up to it.
  */
-#define NONE_WEIGHT32_VALUE INT32_MAX
+#define GRAPH_DIAL_MAX_WEIGHT 1024
+
+/**
+ * Represents a vertex found by graph_nearest_k or by a bounded
+ * search.
+ *
+ * @member vertex the found vertex
+ * @member distance the weight of the weakest path to it
+ */
+struct gnearest {
+    vertex_t vertex;
+    distance_t distance;
+};
+
+/**
+ * Represents a sequence of found vertices.
+ *
+ * @see gnearest_array_destroy
+ *
+ * @member capacity the length of vertices that it can hold
+ * @member len the length of vertices
+ * @member data the vertices with their distances
+ */
+struct gnearest_array {
+    size_t capacity;
+    size_t len;
+
+    struct gnearest* data;
+};
 
 /**
  * Represents the different connected components of a graph.
@@ -40,29 +171,232 @@ struct gcomponent {
     u32vertices_map map;
 };
 
+/**
+ * Represents the landmarks of a graph and the distance from
+ * each of them to every vertex.
+ *
+ * By the triangle inequality, |d(l, t) - d(l, v)| is a lower
+ * bound of d(v, t) for any landmark l that reaches both
+ * vertices.
+ *
+ * @see graph_landmarks
+ * @see glandmarks_destroy
+ *
+ * @member len the length of landmarks
+ * @member requested the length of landmarks that were asked,
+ *                   clamped to vertex_len, len is lower if
+ *                   fewer landmarks cover every vertex
+ * @member vertex_len the length of vertices of the graph
+ * @member vertices the landmark vertices
+ * @member distances the distance from the landmark l to the
+ *                   vertex v at distances[l * vertex_len + v],
+ *                   DISTANCE_MAX if it doesn't reach it
+ */
+struct glandmarks {
+    size_t len;
+    size_t requested;
+    size_t vertex_len;
+
+    vertex_t* vertices;
+    distance_t* distances;
+};
+
+struct graph;
+
+/**
+ * Iterates over the neighbors of a vertex in a graph without
+ * scanning the vertices that are not adjacent to it when the
+ * storage allows it.
+ *
+ * @member graph the graph where it's iterating on
+ * @member vertex the vertex whose neighbors are iterated
+ * @member mask a bitset of vertices to skip, NULL if there is no;
+ *              it can be given after graph_neighbors
+ * @member pos the next position to iterate, its meaning is
+ *             given by the storage (a column, an index, ...)
+ * @member end the position where the iteration finishes
+ */
+struct gneighbor_iterator {
+    const struct graph* graph;
+    vertex_t vertex;
+    const uint64_t* mask;
+    size_t pos;
+    size_t end;
+};
+
+/**
+ * Iterates over the shortest paths between two vertices, one at
+ * a time, by a depth-first walk of the DAG of graph_bfs_dag.
+ *
+ * Besides the DAG, it just keeps the actual path and a neighbor
+ * iterator for each depth.
+ *
+ * @see short_path_iter_init
+ * @see short_path_iter_next
+ * @see short_path_iter_destroy
+ *
+ * @member graph the graph where it's iterating on
+ * @member dag the shortest paths from the source vertex
+ * @member end_vertex the destination vertex
+ * @member hops the length of edges of the paths
+ * @member leads a bitset of the vertices that lead to the
+ *               destination vertex
+ * @member vertices the actual path
+ * @member its the neighbors left to try at each depth
+ * @member depth the depth of the last vertex of the actual path
+ *               whose neighbors are tried
+ * @member pending if the actual path was found but it was not
+ *                 given yet
+ * @member done if there are no more paths
+ */
+struct short_path_iter {
+    const struct graph* graph;
+    struct bfs_dag dag;
+    vertex_t end_vertex;
+    vertex_t hops;
+
+    uint64_t* leads;
+    vertex_t* vertices;
+    struct gneighbor_iterator* its;
+    size_t depth;
+
+    bool pending;
+    bool done;
+};
+
+/**
+ * Represents the operations of a layout that stores the
+ * edges of a graph, the graph dispatches through them, so
+ * several layouts can coexist behind the same API.
+ *
+ * The vertices that are given are always in range, the
+ * edges are undirected (set and del apply both directions)
+ * and the weights that are given to set are never empty.
+ *
+ * A layout that is not built in keeps its data in graph->impl,
+ * it's allocated by reserve (or build) and released by destroy.
+ *
+ * @see graph_init_ops
+ *
+ * @member storage the layout that it implements
+ * @member reserve reserve space for a capacity of vertices and
+ *                 store it in graph->capacity, the new rows
+ *                 must be empty; return false if it couldn't
+ * @member destroy release the space of the layout, it's called
+ *                 by graph_destroy
+ * @member build initialize the layout from an edge list at
+ *               once and store graph->len and graph->capacity,
+ *               NULL to add the edges one by one
+ * @member has check if there is an edge <vi, wj>
+ * @member get return the weight of the edge <vi, wj>, the
+ *             empty weight if there is no
+ * @member set store the edge <vi, wj> with a weight; if it
+ *             couldn't, has must keep returning false
+ * @member del clear the edge <vi, wj>
+ * @member degree return the size of neighbors of a vertex
+ * @member neighbor_init start the iteration of it->vertex, the
+ *                       rest of members except pos and end
+ *                       are already given
+ * @member neighbor_next give the next neighbor that is not in
+ *                       it->mask; return false if there is no
+ *                       more
+ */
+struct graph_ops {
+    enum graph_storage storage;
+
+    bool (*reserve)(struct graph* graph, size_t capacity);
+    void (*destroy)(struct graph* graph);
+    void (*build)(struct graph* graph, size_t len, const struct edge* edges, size_t edge_len);
+
+    bool (*has)(const struct graph* graph, vertex_t vi, vertex_t wj);
+    weight_t (*get)(const struct graph* graph, vertex_t vi, vertex_t wj);
+    void (*set)(struct graph* graph, vertex_t vi, vertex_t wj, weight_t weight);
+    void (*del)(struct graph* graph, vertex_t vi, vertex_t wj);
+    size_t (*degree)(const struct graph* graph, vertex_t vi);
+
+    void (*neighbor_init)(struct gneighbor_iterator* it);
+    bool (*neighbor_next)(struct gneighbor_iterator* it, vertex_t* out_vertex, weight_t* out_weight);
+};
+
 /** 
  * Represents an undirected graph in an adjacency matrix of
- * 32bits.
+ * 32bits (full or just its upper triangle), in an adjacency
+ * matrix of bits or in a compressed sparse row layout.
+ *
+ * The adjacency matrix is a single block aligned to
+ * ROW_ALIGNMENT, where every row is padded up to stride cells
+ * with the empty weight.
  * 
  * @see graph_init
+ * @see graph_init_edges
  * @see graph_destroy
  *
  * @member weighted indicates if the graph is weighted
+ * @member ops the operations of the layout that stores the
+ *            edges, NULL if it was not initialized
  * @member cache is used internally to speed up some operations
- * @member len is the length of vertices that there are in
- * @member matrix stores the edges between two vertices;
+ * @member len is the length of vertices that there are in,
+ *             including the removed ones until it's compacted
+ * @member capacity is the length of vertices that the storage
+ *                  can hold without growing
+ * @member removed a bitset of the vertices that were removed
+ *                 (tombstones), NULL if there is no
+ * @member edge_len the length of edges that there are in
+ * @member max_weight the heaviest weight that was added, it's
+ *                   not lowered when the edge is deleted
+ * @member degree the degree of each vertex, bucketed by degree
+ * @member impl the data of a layout that is not built in, NULL
+ *              if there is no
+ * @member stride the length of cells of a row in matrix
+ * @member matrix stores the edges between two vertices, the
+ *                edge <vi, wj> is at matrix[vi * stride + wj];
  *                if the graph is weighted then it'll store
  *                the given weight otherwise 1
+ * @member words the length of words of a row in bits
+ * @member bits stores the edges when storage is
+ *              GRAPH_STORAGE_BITSET, the edge <vi, wj> is the
+ *              bit wj of the row that starts at bits[vi * words]
+ * @member triangle stores the edges when storage is
+ *                  GRAPH_STORAGE_TRIANGLE, the edge <vi, wj>
+ *                  with vi <= wj is at
+ *                  triangle[wj * (wj + 1) / 2 + vi], so the
+ *                  column of wj is contiguous
+ * @member csr stores the edges when storage is
+ *             GRAPH_STORAGE_CSR
+ * @member lists the neighbors of each vertex when storage is
+ *               GRAPH_STORAGE_INDEXED, in the order that they
+ *               were added (the deleted ones are swapped with
+ *               the last one)
+ * @member positions where wj is in the list of vi, it's at
+ *                   positions[vi * stride + wj] such as matrix
  */
 struct graph {
     bool weighted;
+    const struct graph_ops* ops;
 
     struct {
         struct gcomponent* component;
+        struct glandmarks* landmarks;
     } cache;
 
     size_t len;
-    int32_t** matrix;
+    size_t capacity;
+    uint64_t* removed;
+
+    size_t edge_len;
+    weight_t max_weight;
+    struct gdegree degree;
+
+    void* impl;
+
+    size_t stride;
+    weight_t* matrix;
+    size_t words;
+    uint64_t* bits;
+    weight_t* triangle;
+    struct gcsr csr;
+    struct vertex_array* lists;
+    vertex_t* positions;
 };
 
 /**
@@ -75,6 +409,78 @@ struct graph {
  * @param len the length of vertices that there will be
  */
 void graph_init(struct graph* graph, bool weighted, size_t len);
+/**
+ * Initialize a graph with a given storage from an edge list.
+ *
+ * The edges are applied in the same way that graph_addw
+ * would do, but the CSR storage is built at once in
+ * O(V + E log E) instead of inserting every edge.
+ *
+ * If the graph is weighted, GRAPH_STORAGE_BITSET cannot store
+ * the weights, so GRAPH_STORAGE_MATRIX is used instead. If the
+ * storage is GRAPH_STORAGE_AUTO, then it's picked from the
+ * density that the edge list gives.
+ *
+ * @see graph_init
+ * @see graph_pick_storage
+ *
+ * @param graph the graph to initialize
+ * @param weighted if the graph is weighted
+ * @param len the length of vertices that there will be
+ * @param storage the layout that will store the edges
+ * @param edges the edge list, it can be NULL
+ * @param edge_len the length of edges
+ */
+void graph_init_edges(struct graph* graph,
+                      bool weighted,
+                      size_t len,
+                      enum graph_storage storage,
+                      const struct edge* edges,
+                      size_t edge_len);
+/**
+ * Initialize a graph with the operations of a layout from an
+ * edge list, such as graph_init_edges but it allows layouts
+ * that are not built in.
+ *
+ * @see graph_init_edges
+ *
+ * @param graph the graph to initialize
+ * @param weighted if the graph is weighted
+ * @param len the length of vertices that there will be
+ * @param ops the operations of the layout, they must outlive
+ *            the graph
+ * @param edges the edge list, it can be NULL
+ * @param edge_len the length of edges
+ */
+void graph_init_ops(struct graph* graph,
+                    bool weighted,
+                    size_t len,
+                    const struct graph_ops* ops,
+                    const struct edge* edges,
+                    size_t edge_len);
+/**
+ * Pick the layout that takes less space and is faster to
+ * traverse for a graph, from its density (2E / V^2).
+ *
+ * Weighted graphs use GRAPH_STORAGE_MATRIX from
+ * GRAPH_AUTO_MATRIX_DENSITY and unweighted ones use
+ * GRAPH_STORAGE_BITSET from GRAPH_AUTO_BITSET_DENSITY,
+ * otherwise GRAPH_STORAGE_CSR is used.
+ *
+ * @param weighted if the graph is weighted
+ * @param len the length of vertices
+ * @param edge_len the length of edges, the repeated ones are
+ *                 counted as well
+ * @return the picked layout, it's never GRAPH_STORAGE_AUTO
+ */
+enum graph_storage graph_pick_storage(bool weighted, size_t len, size_t edge_len);
+/**
+ * Return the operations of a built-in layout.
+ *
+ * @param storage the layout, it must not be GRAPH_STORAGE_AUTO
+ * @return the operations, NULL if the layout is not built in
+ */
+const struct graph_ops* graph_storage_ops(enum graph_storage storage);
 /**
  * Print in STDOUT the adjacency matrix of given graph.
  *
@@ -88,6 +494,50 @@ void graph_print(const struct graph* graph);
  */
 void graph_destroy(struct graph* graph);
 
+/**
+ * Add a vertex without edges in the graph.
+ *
+ * The storage grows geometrically, so adding a vertex takes
+ * amortized O(V) time in the dense storages (a new row and
+ * column) and amortized O(1) in GRAPH_STORAGE_CSR. The
+ * connected components that were already computed are
+ * updated instead of being computed again.
+ *
+ * @param graph the graph where to add the vertex
+ * @return the added vertex, VERTEX_T_MAX if it couldn't
+ */
+vertex_t graph_add_vertex(struct graph* graph);
+/**
+ * Remove a vertex and all its edges from the graph.
+ *
+ * The vertex is marked as removed (a tombstone) so the rest
+ * of vertices keep their IDs, and it'll be out of range for
+ * the rest of operations until the graph is compacted. Just
+ * the connected component where the vertex belonged in is
+ * computed again.
+ *
+ * @see graph_compact
+ *
+ * @param graph the graph where to remove the vertex
+ * @param vi the vertex to remove
+ */
+void graph_remove_vertex(struct graph* graph, vertex_t vi);
+/**
+ * Release the space of the removed vertices.
+ *
+ * The remaining vertices are renumbered keeping their order
+ * and the storage is built again with just them.
+ *
+ * @see graph_remove_vertex
+ *
+ * @param graph the graph to compact
+ * @param out_map where it'll store the new vertex of each old
+ *                vertex (VERTEX_T_MAX if it was removed), it
+ *                must have a length of graph->len and it can
+ *                be NULL
+ */
+void graph_compact(struct graph* graph, vertex_t* out_map);
+
 /**
  * Add an edge between two vertices in the graph with a weight.
  *
@@ -100,7 +550,7 @@ void graph_destroy(struct graph* graph);
  * @param weight the edge's weight, if the graph is not
  *               weighted then it'll take in count 1 values
  */
-void graph_addw(struct graph* graph, vertex_t vi, vertex_t wj, int32_t weight);
+void graph_addw(struct graph* graph, vertex_t vi, vertex_t wj, weight_t weight);
 /**
  * Add an edge between two vertices in the graph.
  *
@@ -130,10 +580,10 @@ bool graph_has(const struct graph* graph, vertex_t vi, vertex_t wj);
  * @param graph the graph to look for edge's weight
  * @param vi the source vertex
  * @param wj the destination vertex
- * @return the edge's weighto or NONE_WEIGHT32_VALUE if
+ * @return the edge's weighto or NONE_WEIGHT_VALUE if
  *         there is no
  */
-int32_t graph_get(const struct graph* graph, vertex_t vi, vertex_t wj);
+weight_t graph_get(const struct graph* graph, vertex_t vi, vertex_t wj);
 /**
  * Undo the vertices's edge in the graph.
  *
@@ -144,7 +594,7 @@ int32_t graph_get(const struct graph* graph, vertex_t vi, vertex_t wj);
 void graph_del(struct graph* graph, vertex_t vi, vertex_t wj);
 
 /**
- * Count how many edges a vertice vi in the graph.
+ * Count how many edges a vertice vi in the graph, in O(1).
  *
  * The size goes according to (mathetimatically):
  *     G = (V, A)
@@ -156,7 +606,7 @@ void graph_del(struct graph* graph, vertex_t vi, vertex_t wj);
  */
 size_t graph_rcount(const struct graph* graph, vertex_t vi); 
 /**
- * Count how many edges a vertice wj in the graph.
+ * Count how many edges a vertice wj in the graph, in O(1).
  *
  * The size goes according to (mathetimatically):
  *     G = (V, A)
@@ -167,7 +617,111 @@ size_t graph_rcount(const struct graph* graph, vertex_t vi);
  * @return the size of edges that vertice wj has
  */
 size_t graph_ccount(const struct graph* graph, vertex_t wj); 
+/**
+ * Return how many edges there are in the graph, in O(1).
+ *
+ * An edge <vi, wj> is counted once, such as a loop <vi, vi>.
+ *
+ * @param graph the graph to count its edges
+ * @return the size of edges
+ */
+size_t graph_edge_count(const struct graph* graph);
+/**
+ * Return the minimal degree of the vertices, in O(1).
+ *
+ * The removed vertices count with degree 0 until the graph is
+ * compacted.
+ *
+ * @param graph the graph to look for
+ * @return the minimal degree, 0 if there is no vertex
+ */
+size_t graph_min_degree(const struct graph* graph);
+/**
+ * Return the maximal degree of the vertices, in O(1).
+ *
+ * @param graph the graph to look for
+ * @return the maximal degree, 0 if there is no vertex
+ */
+size_t graph_max_degree(const struct graph* graph);
+/**
+ * Return the vertices that have a given degree, it's a bucket
+ * of the degree histogram.
+ *
+ * The buckets are contiguous in ascending order of degree, so
+ * the vertices can be visited by degree without sorting them.
+ *
+ * @param graph the graph to look for
+ * @param degree the degree of the vertices
+ * @param out_len where it'll store the length of vertices
+ * @return the vertices, they're valid until the graph is
+ *         modified, NULL if there is no
+ */
+const vertex_t* graph_degree_vertices(const struct graph* graph, size_t degree, size_t* out_len);
+
+/**
+ * Initialize an iterator over the neighbors of a vertex, it
+ * visits just the vertices that are adjacent to it when the
+ * storage allows it.
+ *
+ * The neighbors come in ascending order, except in
+ * GRAPH_STORAGE_INDEXED where they come in the order of its
+ * neighbor list.
+ *
+ * Example:
+ *     struct gneighbor_iterator it = {0};
+ *     graph_neighbors(graph, vi, &it);
+ *
+ *     vertex_t wj = 0;
+ *     weight_t weight = 0;
+ *     while (gneighbor_next(&it, &wj, &weight)) {
+ *         ...
+ *     }
+ *
+ * The graph must not be modified while it's iterated.
+ *
+ * @see gneighbor_next
+ *
+ * @param graph the graph where the vertex belongs in
+ * @param vi the vertex whose neighbors will be iterated
+ * @param out_it the iterator to initialize, it'll not give
+ *               neighbors if vi is out of range
+ */
+void graph_neighbors(const struct graph* graph, vertex_t vi, struct gneighbor_iterator* out_it);
+/**
+ * Iterate to the next neighbor.
+ *
+ * @see graph_neighbors
+ *
+ * @param it the iterator where it'll look for the next neighbor
+ * @param out_vertex the found neighbor
+ * @param out_weight the edge's weight, it can be NULL
+ * @return true if it could find another neighbor, otherwise false
+ */
+bool gneighbor_next(struct gneighbor_iterator* it, vertex_t* out_vertex, weight_t* out_weight);
 
+/**
+ * Find the vertices up to a length of edges from a vertex, by a
+ * breadth-first search that doesn't go deeper.
+ *
+ * The visited vertices are kept in a table of the search, so it
+ * takes time and space by the vertices that it finds and their
+ * edges instead of the graph.
+ *
+ * @see graph_wave
+ *
+ * @param graph the graph to search
+ * @param start_vertex the source vertex, it's not included
+ * @param max_depth the greatest length of edges
+ * @param out_array where it'll store the vertices by layer with
+ *                  their hops as distance, it must be destroyed
+ *                  by gnearest_array_destroy
+ * @return true if it could search, otherwise false and
+ *         out_array is empty
+ */
+bool graph_wave_bounded(const struct graph* graph,
+                        vertex_t start_vertex,
+                        size_t max_depth,
+                        struct gnearest_array* out_array);
 /**
  * Generate the waves from a start vertex until a possible end
  * vertex.
@@ -208,6 +762,29 @@ void graph_components(struct graph* graph, const struct gcomponent** out_comp);
  * @return true if reachable, otherwise false
  */
 bool graph_reachable(struct graph* graph, vertex_t start_vertex, vertex_t end_vertex);
+/**
+ * Find the shortest paths in edges from a vertex to the others
+ * in the graph, as a DAG of predecessors.
+ *
+ * It's a breadth-first search that takes O(V + E) time and
+ * space, and it stops as soon as the layer of the destination
+ * vertex is complete, so every shortest path to it is in the
+ * DAG.
+ *
+ * @see bfs_dag_parents
+ *
+ * @param graph the graph to evalue the paths
+ * @param start_vertex the source vertex
+ * @param end_vertex the destination vertex, VERTEX_T_MAX to
+ *                   find the paths to all vertices
+ * @param out_dag where it'll be stored the DAG, it must be
+ *                destroyed by bfs_dag_destroy, its len is 0 if
+ *                it couldn't find the paths
+ */
+void graph_bfs_dag(const struct graph* graph,
+                   vertex_t start_vertex,
+                   vertex_t end_vertex,
+                   struct bfs_dag* out_dag);
 /**
  * Find the shortest paths between two vertices in the graph.
  *
@@ -218,6 +795,9 @@ bool graph_reachable(struct graph* graph, vertex_t start_vertex, vertex_t end_ve
  *   3. It can exist several paths that are equivally shorts,
  *      thereby it will be included too.
  *
+ * The paths are enumerated from the DAG of graph_bfs_dag, just
+ * through the vertices that lead to the destination vertex.
+ *
  * @param graph the graph to evalue the shortest path
  * @param start_vertex the source vertex
  * @param end_vertex the destination vertex
@@ -227,6 +807,203 @@ void graph_short_path(struct graph* graph,
                       vertex_t start_vertex,
                       vertex_t end_vertex,
                       u32vertices_map* out_map);
+/**
+ * Count the shortest paths between two vertices in the graph,
+ * without building them.
+ *
+ * A breadth-first search adds up the paths of the parents of
+ * each vertex, so it takes O(V + E) time and O(V) space however
+ * many paths there are. The count is the same as the length of
+ * paths of graph_short_path.
+ *
+ * @param graph the graph to evalue the shortest paths
+ * @param start_vertex the source vertex
+ * @param end_vertex the destination vertex
+ * @return the length of paths, 0 if there is no or both are the
+ *         same vertex, UINT64_MAX if there are UINT64_MAX or
+ *         more
+ */
+uint64_t graph_short_path_count(const struct graph* graph, vertex_t start_vertex, vertex_t end_vertex);
+/**
+ * Initialize an iterator over the shortest paths between two
+ * vertices.
+ *
+ * The paths come in the same order as graph_short_path gives
+ * them, and the graph must not be modified while iterating.
+ *
+ * @see short_path_iter_next
+ *
+ * @param it the iterator to initialize
+ * @param graph the graph where the vertices belong in
+ * @param start_vertex the source vertex
+ * @param end_vertex the destination vertex
+ * @return true if it could initialize it, otherwise false
+ */
+bool short_path_iter_init(struct short_path_iter* it,
+                          const struct graph* graph,
+                          vertex_t start_vertex,
+                          vertex_t end_vertex);
+/**
+ * Write the next shortest path in a buffer.
+ *
+ * The vertices are written from the source vertex until the
+ * destination vertex, just if the buffer can hold all of them,
+ * otherwise the path is kept for the next call, so the length
+ * can be asked first with a NULL buffer.
+ *
+ * @param it the iterator where to look for the next path
+ * @param out_vertices where it'll store the vertices, it can be
+ *                     NULL
+ * @param capacity the length of vertices that out_vertices can
+ *                 hold
+ * @return the length of vertices of the path, 0 if there are no
+ *         more paths
+ */
+size_t short_path_iter_next(struct short_path_iter* it, vertex_t* out_vertices, size_t capacity);
+/**
+ * Destroy an initialized iterator.
+ *
+ * @param it the iterator to destroy
+ */
+void short_path_iter_destroy(struct short_path_iter* it);
+/**
+ * Find the weakest paths from a vertex to the others in the
+ * graph, as a tree of predecessors.
+ *
+ * The vertices are settled in order of distance by a d-ary
+ * heap (Dijkstra), so it takes O((V + E) log V) time and O(V)
+ * space, and it stops once every vertex as far as the
+ * destination vertex is settled. Just the settled vertices have
+ * a path in the tree.
+ *
+ * If several paths are equally weak, the parent is picked by
+ * graph_sssp_ties, so the tree doesn't depend on the order of
+ * the queue.
+ *
+ * If the weights are integers up to GRAPH_DIAL_MAX_WEIGHT, the
+ * heap is replaced by a bucket queue, so it takes
+ * O(V + E + D) time where D is the greatest distance.
+ *
+ * The weights must not be negative.
+ *
+ * @see sssp_tree_path
+ *
+ * @param graph the graph to evalue the paths
+ * @param start_vertex the source vertex
+ * @param end_vertex the destination vertex, VERTEX_T_MAX to
+ *                   find the paths to all vertices
+ * @param out_tree where it'll be stored the tree, it must be
+ *                 destroyed by sssp_tree_destroy, its len is 0
+ *                 if it couldn't find the paths
+ */
+void graph_sssp(struct graph* graph,
+                vertex_t start_vertex,
+                vertex_t end_vertex,
+                struct sssp_tree* out_tree);
+/**
+ * Pick the parents of a tree of weakest paths by a single rule,
+ * so every search that finds the tree gives the same one.
+ *
+ * The parent of a vertex is the lowest one that reaches it from
+ * a lower distance. The searches keep it while they relax the
+ * edges, and this just fixes the vertices that are reached by
+ * zero weight edges alone: the parent is the lowest one with
+ * the fewest zero weight edges back to a vertex of the former
+ * kind. It takes O(V) time, plus the degrees of those vertices
+ * if there are any.
+ *
+ * @see graph_sssp
+ * @see graph_sssp_delta
+ *
+ * @param graph the graph where the tree was found
+ * @param tree the tree whose parents are picked
+ */
+void graph_sssp_ties(const struct graph* graph, struct sssp_tree* tree);
+/**
+ * Find the weakest paths from a vertex to the others in the
+ * graph by delta-stepping, in several threads.
+ *
+ * The vertices are kept in buckets of width delta by distance.
+ * The buckets are settled in order, the edges up to delta
+ * (light) are relaxed in rounds until the bucket stays empty
+ * and then the heavier ones are relaxed once. Every thread
+ * owns the vertices v where v % threads is its ID, and the
+ * relaxations are sent to the owner, so the vertices are
+ * modified without locks.
+ *
+ * Every thread keeps a ring of ceil(W / delta) + 1 buckets,
+ * where W is the heaviest weight, since a relaxation never
+ * reaches further ahead of the actual bucket.
+ *
+ * The tree is the same as graph_sssp for any length of
+ * threads: the ties keep the lowest parent from a lower
+ * distance and graph_sssp_ties picks the rest, and with a
+ * destination vertex every vertex up to its distance is kept.
+ * The weights must not be negative.
+ *
+ * @see graph_sssp
+ *
+ * @param graph the graph to evalue the paths
+ * @param start_vertex the source vertex
+ * @param end_vertex the destination vertex, VERTEX_T_MAX to
+ *                   find the paths to all vertices
+ * @param delta the width of a bucket, 0 to take the heaviest
+ *              edge
+ * @param threads the length of threads, 0 to take one for each
+ *                processor
+ * @param out_tree where it'll be stored the tree, it must be
+ *                 destroyed by sssp_tree_destroy, its len is 0
+ *                 if it couldn't find the paths
+ */
+void graph_sssp_delta(struct graph* graph,
+                      vertex_t start_vertex,
+                      vertex_t end_vertex,
+                      distance_t delta,
+                      size_t threads,
+                      struct sssp_tree* out_tree);
+/**
+ * Find the k vertices with the weakest paths from a vertex.
+ *
+ * The search stops as soon as the k-th vertex is settled, and
+ * it keeps the touched vertices in a table of its own instead
+ * of an array of the graph's length, so it takes
+ * O(T log T) time and O(T) space where T is the length of
+ * edges of the settled vertices, whatever the size of the
+ * component.
+ *
+ * The weights must not be negative.
+ *
+ * @param graph the graph to search
+ * @param vi the source vertex, it's not included
+ * @param k the length of vertices to find
+ * @param out where it'll store the vertices by ascending
+ *            distance, it must hold k of them
+ * @return the length of found vertices, it's lower than k if
+ *         there are no more reachable, 0 if it couldn't
+ *         allocate memory
+ */
+size_t graph_nearest_k(struct graph* graph, vertex_t vi, size_t k, struct gnearest* out);
+/**
+ * Find the vertices whose weakest path from a vertex weighs up
+ * to a budget.
+ *
+ * It's such as graph_nearest_k, the search doesn't touch the
+ * vertices beyond the budget and it keeps its own table, so it
+ * takes time and space by the ball instead of the graph.
+ *
+ * @param graph the graph to search
+ * @param start_vertex the source vertex, it's not included
+ * @param max_distance the budget, the greatest distance to find
+ * @param out_array where it'll store the vertices by ascending
+ *                  distance, it must be destroyed by
+ *                  gnearest_array_destroy
+ * @return true if it could search, otherwise false and
+ *         out_array is empty
+ */
+bool graph_minimal_path_bounded(struct graph* graph,
+                                vertex_t start_vertex,
+                                distance_t max_distance,
+                                struct gnearest_array* out_array);
 /**
  * Find the weakest paths between two vertices in the graph.
  *
@@ -237,6 +1014,10 @@ void graph_short_path(struct graph* graph,
  *   3. It'll store all weakest paths found until to reach
  *      the destination vertex, all of them if VERTEX_T_MAX is
  *      present.
+ *   4. The weights must not be negative.
+ *
+ * Every path is copied from graph_sssp into the map, so
+ * graph_sssp is preferred when not all paths are needed.
  *
  * @param graph the graph to evalue the shortest path
  * @param start_vertex the source vertex
@@ -248,11 +1029,75 @@ void graph_minimal_path(struct graph* graph,
                         vertex_t end_vertex,
                         u32path_map* out_map);
 
+/**
+ * Find the weakest paths between two vertices in the graph by
+ * a given search.
+ *
+ * The output is the same as graph_minimal_path, but
+ * GRAPH_PATH_BIDIRECTIONAL and GRAPH_PATH_ALT store just the
+ * path to the destination vertex, they explore far less
+ * vertices when both of them are close in a large graph. They
+ * fall back to GRAPH_PATH_DIJKSTRA when the destination is
+ * VERTEX_T_MAX.
+ *
+ * GRAPH_PATH_ALT uses the cached landmarks, it picks
+ * GRAPH_ALT_LANDMARKS of them if there are no.
+ *
+ * GRAPH_PATH_DELTA_STEPPING stores the same paths such as
+ * GRAPH_PATH_DIJKSTRA.
+ *
+ * @see graph_minimal_path
+ *
+ * @param graph the graph to evalue the shortest path
+ * @param start_vertex the source vertex
+ * @param end_vertex the destination vertex
+ * @param mode the search to use
+ * @param out_map where it'll be stored the paths found
+ */
+void graph_minimal_path_mode(struct graph* graph,
+                             vertex_t start_vertex,
+                             vertex_t end_vertex,
+                             enum graph_path_mode mode,
+                             u32path_map* out_map);
+
+/**
+ * Pick landmarks of the graph and compute the distances from
+ * them to every vertex, they are used by GRAPH_PATH_ALT.
+ *
+ * The first landmark is the farthest vertex from an arbitrary
+ * one and each next one is the farthest vertex from the picked
+ * ones, so the vertices of every connected component are
+ * covered before spreading more landmarks in the same one. It
+ * takes k searches of O((V + E) log V) time and O(k V) space.
+ *
+ * The landmarks are cached until the graph is modified, and
+ * they're picked again just if k is different.
+ *
+ * @param graph the graph to pick its landmarks
+ * @param k the length of landmarks, it's at most the length of
+ *          vertices
+ * @param out_landmarks where it'll store the landmarks but in
+ *                      read-only mode, out_landmarks can be NULL
+ */
+void graph_landmarks(struct graph* graph, size_t k, const struct glandmarks** out_landmarks);
+
 /**
  * Destroy an initialized component.
  *
  * @param comp the component to destroy
  */
 void gcomponent_destroy(struct gcomponent* comp);
+/**
+ * Destroy initialized landmarks.
+ *
+ * @param landmarks the landmarks to destroy
+ */
+void glandmarks_destroy(struct glandmarks* landmarks);
+/**
+ * Destroy an initialized array of found vertices.
+ *
+ * @param array the array to destroy
+ */
+void gnearest_array_destroy(struct gnearest_array* array);
 
 #endif // ED_GRAPH_GUARD_HEADER
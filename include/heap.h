@@ -0,0 +1,200 @@
+#ifndef ED_HEAP_GUARD_HEADER
+#define ED_HEAP_GUARD_HEADER
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "vertex.h"
+#include "weight.h"
+
+/**
+ * Represents how many children a node of the heap has, a wider
+ * node makes the heap shallower so a decrease-key climbs less
+ * levels, and the children of a node share a cache line.
+ */
+#define HEAP_ARITY 4
+
+/**
+ * Represents a min-heap of vertices keyed by a distance_t,
+ * where a vertex is at most once.
+ *
+ * It's indexed by vertex, so the key of a queued vertex can be
+ * decreased in O(log V) instead of queueing it again.
+ *
+ * @see heap_vertex_init
+ * @see heap_vertex_destroy
+ *
+ * @member len the length of vertices that it can hold
+ * @member size the length of queued vertices
+ * @member data the queued vertices in heap order
+ * @member keys the key of each queued vertex in heap order
+ * @member positions where each vertex is in data, SIZE_MAX if
+ *                   it isn't queued
+ */
+struct heap_vertex {
+    size_t len;
+    size_t size;
+
+    vertex_t* data;
+    distance_t* keys;
+    size_t* positions;
+};
+
+/**
+ * Initialize an empty heap for the vertices [0, len).
+ *
+ * @param heap the heap to initialize
+ * @param len the length of vertices
+ * @return true if it could allocate the heap, otherwise false
+ */
+bool heap_vertex_init(struct heap_vertex* heap, size_t len);
+/**
+ * Destroy an initialized heap.
+ *
+ * @param heap the heap to destroy
+ */
+void heap_vertex_destroy(struct heap_vertex* heap);
+
+/**
+ * Add a vertex with a key, if the vertex is already queued
+ * then it just decreases its key.
+ *
+ * @param heap the heap where to add the vertex
+ * @param vertex the vertex to add
+ * @param key the key of the vertex
+ * @return true if the vertex was added or its key decreased,
+ *         false if it's queued with a lower or equal key
+ */
+bool heap_vertex_push(struct heap_vertex* heap, vertex_t vertex, distance_t key);
+/**
+ * Extract the vertex with the minimal key.
+ *
+ * @param heap the heap where to extract the vertex from
+ * @param out_key where it'll store the key, it can be NULL
+ * @return the vertex, VERTEX_T_MAX if the heap is empty
+ */
+vertex_t heap_vertex_pop(struct heap_vertex* heap, distance_t* out_key);
+
+/**
+ * Return the minimal key without extracting its vertex.
+ *
+ * @param heap the heap to look for
+ * @return the minimal key, DISTANCE_MAX if the heap is empty
+ */
+static inline distance_t heap_vertex_top(const struct heap_vertex* heap) {
+    return heap->size > 0 ? heap->keys[0] : DISTANCE_MAX;
+}
+
+/**
+ * Check if the heap is empty.
+ *
+ * @param heap the heap to check
+ * @return true if it's empty, otherwise false
+ */
+static inline bool heap_vertex_empty(const struct heap_vertex* heap) {
+    return heap->size == 0;
+}
+
+/**
+ * Check if a vertex is queued.
+ *
+ * @param heap the heap to check
+ * @param vertex the vertex to look for
+ * @return true if it's queued, otherwise false
+ */
+static inline bool heap_vertex_contains(const struct heap_vertex* heap, vertex_t vertex) {
+    return vertex < heap->len && heap->positions[vertex] != SIZE_MAX;
+}
+
+/**
+ * Represents a monotone bucket queue (Dial's algorithm) of
+ * vertices keyed by an integer distance_t, where a vertex is at
+ * most once.
+ *
+ * Every queued key is in [cursor, cursor + span), so a key goes
+ * into the bucket key % span of a circular array, and the
+ * minimal key is found by moving the cursor forward. A push is
+ * O(1) and the pops take O(span) in total for every distance
+ * that was reached, without comparing keys. It suits the
+ * searches whose edges weigh at most span - 1, where the
+ * extracted keys never decrease.
+ *
+ * @see heap_dial_init
+ * @see heap_dial_destroy
+ *
+ * @member len the length of vertices that it can hold
+ * @member size the length of queued vertices
+ * @member span the length of buckets
+ * @member cursor the minimal key that can be queued
+ * @member heads the first vertex of each bucket, VERTEX_T_MAX
+ *               if it's empty
+ * @member next the next vertex in the bucket of each vertex
+ * @member prev the previous vertex in the bucket of each vertex,
+ *              VERTEX_T_MAX if it's the first one
+ * @member keys the key of each vertex, DISTANCE_MAX if it isn't
+ *              queued
+ */
+struct heap_dial {
+    size_t len;
+    size_t size;
+    size_t span;
+    distance_t cursor;
+
+    vertex_t* heads;
+    vertex_t* next;
+    vertex_t* prev;
+    distance_t* keys;
+};
+
+/**
+ * Initialize an empty bucket queue for the vertices [0, len).
+ *
+ * @param heap the queue to initialize
+ * @param len the length of vertices
+ * @param max_step the maximal difference between a queued key
+ *                 and the minimal one, that is the heaviest edge
+ * @return true if it could allocate the queue, otherwise false
+ */
+bool heap_dial_init(struct heap_dial* heap, size_t len, size_t max_step);
+/**
+ * Destroy an initialized bucket queue.
+ *
+ * @param heap the queue to destroy
+ */
+void heap_dial_destroy(struct heap_dial* heap);
+
+/**
+ * Add a vertex with a key, if the vertex is already queued
+ * then it just decreases its key.
+ *
+ * The key can't be lower than the last extracted one, nor go
+ * beyond it by max_step.
+ *
+ * @param heap the queue where to add the vertex
+ * @param vertex the vertex to add
+ * @param key the key of the vertex
+ * @return true if the vertex was added or its key decreased,
+ *         false if it's queued with a lower or equal key
+ */
+bool heap_dial_push(struct heap_dial* heap, vertex_t vertex, distance_t key);
+/**
+ * Extract a vertex with the minimal key.
+ *
+ * @param heap the queue where to extract the vertex from
+ * @param out_key where it'll store the key, it can be NULL
+ * @return the vertex, VERTEX_T_MAX if the queue is empty
+ */
+vertex_t heap_dial_pop(struct heap_dial* heap, distance_t* out_key);
+
+/**
+ * Check if the bucket queue is empty.
+ *
+ * @param heap the queue to check
+ * @return true if it's empty, otherwise false
+ */
+static inline bool heap_dial_empty(const struct heap_dial* heap) {
+    return heap->size == 0;
+}
+
+#endif // ED_HEAP_GUARD_HEADER
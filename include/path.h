@@ -2,8 +2,11 @@
 #define ED_PATH_GUARD_HEADER
 
 #include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
 
 #include "vertex.h"
+#include "weight.h"
 #include "map.h"
 
 /**
@@ -18,7 +21,7 @@
  */
 struct path {
     struct vertex_array vertices;
-    int32_t weight;
+    distance_t weight;
 };
 
 /**
@@ -32,6 +35,155 @@ struct path {
  */
 typedef struct hashmap u32path_map;
 
+/**
+ * Represents the minimal paths from a source vertex to the
+ * others, as a tree where each vertex links to the vertex that
+ * precedes it.
+ *
+ * It takes O(V) space whatever the length of the paths, and a
+ * path is built on demand by sssp_tree_path.
+ *
+ * @see sssp_tree_init
+ * @see sssp_tree_destroy
+ *
+ * @member len the length of vertices that there are in
+ * @member source the source vertex of the paths
+ * @member distances the weight of the path to each vertex,
+ *                   DISTANCE_MAX if there is no path
+ * @member parents the vertex that precedes each vertex in its
+ *                 path, VERTEX_T_MAX for the source vertex or
+ *                 if there is no path
+ */
+struct sssp_tree {
+    size_t len;
+    vertex_t source;
+
+    distance_t* distances;
+    vertex_t* parents;
+};
+
+/**
+ * Initialize a tree where just the source vertex has a path.
+ *
+ * @param tree the tree to initialize
+ * @param len the length of vertices
+ * @param source the source vertex, it must be lower than len
+ * @return true if it could allocate the tree, otherwise false
+ */
+bool sssp_tree_init(struct sssp_tree* tree, size_t len, vertex_t source);
+/**
+ * Destroy an initialized tree.
+ *
+ * @param tree the tree to destroy
+ */
+void sssp_tree_destroy(struct sssp_tree* tree);
+/**
+ * Build the path from the source vertex to a vertex.
+ *
+ * The vertices are written from the source vertex until the
+ * given one, just if the buffer can hold all of them, so the
+ * length can be asked first with a NULL buffer.
+ *
+ * @param tree the tree where the path is
+ * @param vertex the destination vertex
+ * @param out_vertices where it'll store the vertices, it can be
+ *                     NULL
+ * @param capacity the length of vertices that out_vertices can
+ *                 hold
+ * @return the length of vertices of the path, 0 if there is no
+ */
+size_t sssp_tree_path(const struct sssp_tree* tree,
+                      vertex_t vertex,
+                      vertex_t* out_vertices,
+                      size_t capacity);
+
+/**
+ * Return the weight of the path to a vertex.
+ *
+ * @param tree the tree where the path is
+ * @param vertex the destination vertex
+ * @return the weight, DISTANCE_MAX if there is no path
+ */
+static inline distance_t sssp_tree_distance(const struct sssp_tree* tree, vertex_t vertex) {
+    return vertex < tree->len ? tree->distances[vertex] : DISTANCE_MAX;
+}
+
+/**
+ * Represents the shortest paths in edges from a source vertex
+ * to the others, as a directed acyclic graph of breadth-first
+ * layers where each vertex links to all the vertices that
+ * precede it in some shortest path.
+ *
+ * It takes O(V + E) space whatever the length of paths there
+ * are, while enumerating them can take exponential space.
+ *
+ * @see bfs_dag_init
+ * @see bfs_dag_destroy
+ *
+ * @member len the length of vertices that there are in
+ * @member source the source vertex of the paths
+ * @member hops the length of edges of the paths to each vertex,
+ *              VERTEX_T_MAX if there is no path
+ * @member offsets where the parents of each vertex start at, it
+ *                 has len + 1 elements
+ * @member parents the vertices that precede each vertex, they're
+ *                 one hop closer to the source vertex
+ */
+struct bfs_dag {
+    size_t len;
+    vertex_t source;
+
+    vertex_t* hops;
+    size_t* offsets;
+    vertex_t* parents;
+};
+
+/**
+ * Initialize a DAG where just the source vertex has a path, and
+ * no vertex has parents.
+ *
+ * @param dag the DAG to initialize
+ * @param len the length of vertices
+ * @param source the source vertex, it must be lower than len
+ * @return true if it could allocate the DAG, otherwise false
+ */
+bool bfs_dag_init(struct bfs_dag* dag, size_t len, vertex_t source);
+/**
+ * Destroy an initialized DAG.
+ *
+ * @param dag the DAG to destroy
+ */
+void bfs_dag_destroy(struct bfs_dag* dag);
+
+/**
+ * Return the length of edges of the shortest paths to a vertex.
+ *
+ * @param dag the DAG where the paths are
+ * @param vertex the destination vertex
+ * @return the hops, VERTEX_T_MAX if there is no path
+ */
+static inline vertex_t bfs_dag_hops(const struct bfs_dag* dag, vertex_t vertex) {
+    return vertex < dag->len ? dag->hops[vertex] : VERTEX_T_MAX;
+}
+/**
+ * Return the vertices that precede a vertex in its shortest
+ * paths.
+ *
+ * @param dag the DAG where the paths are
+ * @param vertex the vertex
+ * @param out_len where it'll store the length of parents
+ * @return the parents, NULL if there is no
+ */
+static inline const vertex_t* bfs_dag_parents(const struct bfs_dag* dag, vertex_t vertex, size_t* out_len) {
+    if (vertex >= dag->len || dag->parents == NULL) {
+        *out_len = 0;
+        return NULL;
+    }
+
+    *out_len = dag->offsets[vertex + 1] - dag->offsets[vertex];
+    return &dag->parents[dag->offsets[vertex]];
+}
+
 /**
  * Initialize a path with the vertices that compose it
  *
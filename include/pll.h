@@ -0,0 +1,99 @@
+#ifndef ED_PLL_GUARD_HEADER
+#define ED_PLL_GUARD_HEADER
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "vertex.h"
+
+struct graph;
+
+/**
+ * Represents a pruned landmark labeling (2-hop hub labels) of
+ * the unweighted view of a graph.
+ *
+ * Every vertex has a label of hubs, and for any two vertices a
+ * weakest path in hops goes through a hub in both labels, so the
+ * hops between them are the lower sum of the common hubs. The
+ * labels are sorted by hub, so a query is a merge of two small
+ * runs.
+ *
+ * @see gpll_init
+ * @see gpll_load
+ * @see gpll_destroy
+ *
+ * @member len the length of vertices
+ * @member order the vertex of each rank, the hubs are ranks
+ * @member offsets where the label of each vertex starts at, it
+ *                 has len + 1 elements
+ * @member hubs the rank of the hub of each entry of the labels
+ * @member hops the length of edges from the vertex to the hub
+ *              of each entry of the labels
+ */
+struct gpll {
+    size_t len;
+    vertex_t* order;
+
+    size_t* offsets;
+    vertex_t* hubs;
+    uint32_t* hops;
+};
+
+/**
+ * Build the labels of a graph, the weights are ignored.
+ *
+ * The vertices are taken as hubs by descending degree and a
+ * breadth-first search from each of them stops at the vertices
+ * whose hops are already covered by the previous hubs. It takes
+ * O(V + E) time per hub in the worst case, but the pruning
+ * keeps the labels small in graphs with hubs.
+ *
+ * @param pll the labels to build
+ * @param graph the graph to build from
+ * @return true if it could build the labels, otherwise false
+ */
+bool gpll_init(struct gpll* pll, struct graph* graph);
+/**
+ * Destroy initialized labels.
+ *
+ * @param pll the labels to destroy
+ */
+void gpll_destroy(struct gpll* pll);
+
+/**
+ * Return the length of edges of a shortest path between two
+ * vertices.
+ *
+ * @param pll the labels to query
+ * @param vi a vertex
+ * @param wj another vertex
+ * @return the hops, SIZE_MAX if there is no path
+ */
+size_t gpll_hops(const struct gpll* pll, vertex_t vi, vertex_t wj);
+
+/**
+ * Write the labels into a binary file, so they can be loaded in
+ * another run without building them again.
+ *
+ * @param pll the labels to write
+ * @param file the file where to write
+ * @return true if it could write them, otherwise false
+ */
+bool gpll_save(const struct gpll* pll, FILE* file);
+/**
+ * Read labels that were written by gpll_save.
+ *
+ * The file must come from a machine with the same byte order
+ * and a build with the same VERTEX_BITS, and it must be
+ * seekable, since the header is checked against its size
+ * before allocating the labels.
+ *
+ * @param pll the labels to initialize
+ * @param file the file where to read
+ * @return true if it could read them, otherwise false
+ */
+bool gpll_load(struct gpll* pll, FILE* file);
+
+#endif // ED_PLL_GUARD_HEADER
@@ -0,0 +1,65 @@
+#ifndef ED_ROW_GUARD_HEADER
+#define ED_ROW_GUARD_HEADER
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "weight.h"
+
+/**
+ * Represents the alignment (in bytes) of the rows of an
+ * adjacency matrix, it matches a cache line.
+ */
+#define ROW_ALIGNMENT 64
+
+/**
+ * Return the padded length of a row, such that every row
+ * starts in a ROW_ALIGNMENT boundary.
+ *
+ * @param len the length of cells in a row
+ * @return the length of cells with padding
+ */
+static inline size_t row_stride(size_t len) {
+    size_t cells = ROW_ALIGNMENT / sizeof(weight_t);
+    return (len + cells - 1) / cells * cells;
+}
+
+/**
+ * Count how many cells of a row are different from a value.
+ *
+ * It uses AVX2 or SSE2 when the processor supports them,
+ * otherwise it falls back to a scalar loop.
+ *
+ * @param row the row to scan
+ * @param len the length of cells to scan
+ * @param empty the value to skip
+ * @return the size of cells that are not empty
+ */
+size_t row_count(const weight_t* row, size_t len, weight_t empty);
+/**
+ * Look for the first cell of a row that is different from
+ * a value.
+ *
+ * It uses AVX2 or SSE2 when the processor supports them,
+ * otherwise it falls back to a scalar loop.
+ *
+ * @param row the row to scan
+ * @param from the position where it starts to scan at
+ * @param len the length of cells of the row
+ * @param empty the value to skip
+ * @return the position of the found cell, len if there is no
+ */
+size_t row_find(const weight_t* row, size_t from, size_t len, weight_t empty);
+/**
+ * Count how many bits are set in a row of a bitset.
+ *
+ * It uses the POPCNT instruction when the processor supports
+ * it, otherwise it falls back to a portable count.
+ *
+ * @param words the words of the row
+ * @param len the length of words
+ * @return the size of set bits
+ */
+size_t row_popcount(const uint64_t* words, size_t len);
+
+#endif // ED_ROW_GUARD_HEADER
@@ -1,19 +1,64 @@
 #ifndef ED_VERTEX_GUARD_HEADER
 #define ED_VERTEX_GUARD_HEADER
 
+#include <stdint.h>
 #include <stddef.h>
 #include <stdlib.h>
 
 #include "map.h"
 #include "list.h"
+#include "weight.h"
 
-#define VERTEX_T_MAX SIZE_MAX
+/*
+ * The width of the vertices is picked at build time, every
+ * vertex sequence, queue, wave and path takes half the space
+ * with VERTEX_BITS=32 (by default it's 64).
+ */
+#ifndef VERTEX_BITS
+#define VERTEX_BITS 64
+#endif
+
+#if VERTEX_BITS == 32
 
 /**
  * Represents a vertex.
  */
+typedef uint32_t vertex_t;
+
+/**
+ * Represents the value that indicates that there is no vertex.
+ */
+#define VERTEX_T_MAX UINT32_MAX
+
+/**
+ * Represents the printf/scanf conversion of vertex_t.
+ */
+#define VERTEX_PRI "u"
+
+#elif VERTEX_BITS == 64
+
 typedef size_t vertex_t;
 
+#define VERTEX_T_MAX SIZE_MAX
+#define VERTEX_PRI "lu"
+
+#else
+#error "VERTEX_BITS must be 32 or 64"
+#endif
+
+/**
+ * Represents an undirected edge between two vertices.
+ *
+ * @member vi the source vertex
+ * @member wj the destination vertex
+ * @member weight the edge's weight
+ */
+struct edge {
+    vertex_t vi;
+    vertex_t wj;
+    weight_t weight;
+};
+
 /**
  * Represents a HashMap that links uint32_t (the key) with a
  * struct vertex_array (the value).
@@ -28,10 +73,20 @@ typedef struct hashmap u32vertices_map;
 /**
  * Represents a queue that stores vertex_t.
  *
- * @member internal the queue used internally
+ * The vertices are stored by value in a circular buffer, so a
+ * queued vertex takes just sizeof(vertex_t).
+ *
+ * @member capacity the length of vertices that data can hold
+ * @member head the position of the first vertex in data
+ * @member size the length of queued vertices
+ * @member data the circular buffer of vertices
  */
 struct queue_vertex {
-    queue_t internal;
+    size_t capacity;
+    size_t head;
+    size_t size;
+
+    vertex_t* data;
 };
 
 /**
@@ -94,7 +149,10 @@ void vertex_array_destroy(struct vertex_array* array);
  * @param queue tthe queue to initialize
  */
 static inline void queue_vertex_init(struct queue_vertex* queue) {
-    queue_init(&queue->internal, free);
+    queue->capacity = 0;
+    queue->head = 0;
+    queue->size = 0;
+    queue->data = NULL;
 }
 
 /**
@@ -104,7 +162,7 @@ static inline void queue_vertex_init(struct queue_vertex* queue) {
  * @return true if it's empty, otherwise false
  */
 static inline bool queue_vertex_empty(struct queue_vertex* queue) {
-    return queue_empty(&queue->internal);
+    return queue->size == 0;
 }
 
 /**
@@ -114,7 +172,7 @@ static inline bool queue_vertex_empty(struct queue_vertex* queue) {
  * @return the queue size
  */
 static inline size_t queue_vertex_size(struct queue_vertex* queue) {
-    return queue->internal.size;
+    return queue->size;
 }
 
 /**
@@ -123,7 +181,8 @@ static inline size_t queue_vertex_size(struct queue_vertex* queue) {
  * @param queue the queue to destroy
  */
 static inline void queue_vertex_destroy(struct queue_vertex* queue) {
-    queue_destroy(&queue->internal);
+    free(queue->data);
+    queue_vertex_init(queue);
 }
 
 /**
@@ -133,10 +192,23 @@ static inline void queue_vertex_destroy(struct queue_vertex* queue) {
  * @param vertex the vertex to add
  */
 static inline void queue_vertex_add(struct queue_vertex* queue, vertex_t vertex) {
-    vertex_t* vertex_ptr = malloc(sizeof(vertex_t));
-    *vertex_ptr = vertex;
+    if (queue->size >= queue->capacity) {
+        size_t capacity = queue->capacity > 0 ? queue->capacity * 2 : 16;
+        vertex_t* data = malloc(sizeof(vertex_t) * capacity);
+
+        // unroll the circular buffer at the start of new one
+        for (size_t k = 0; k < queue->size; k++) {
+            data[k] = queue->data[(queue->head + k) % queue->capacity];
+        }
+
+        free(queue->data);
+        queue->capacity = capacity;
+        queue->head = 0;
+        queue->data = data;
+    }
 
-    queue_add(&queue->internal, vertex_ptr);
+    queue->data[(queue->head + queue->size) % queue->capacity] = vertex;
+    queue->size++;
 }
 
 /**
@@ -146,13 +218,14 @@ static inline void queue_vertex_add(struct queue_vertex* queue, vertex_t vertex)
  * @return the vertex, VERTEX_T_MAX if the queue is empty
  */
 static inline vertex_t queue_vertex_del(struct queue_vertex* queue) {
-    vertex_t* vertex_ptr = queue_del(&queue->internal);
-    if (vertex_ptr == NULL) {
+    if (queue->size == 0) {
         return VERTEX_T_MAX;
     }
 
-    vertex_t vertex = *vertex_ptr;
-    free(vertex_ptr);
+    vertex_t vertex = queue->data[queue->head];
+    queue->head = (queue->head + 1) % queue->capacity;
+    queue->size--;
+
     return vertex;
 }
 
@@ -2,59 +2,100 @@
 #define ED_WAVE_GUARD_HEADER
 
 #include <stdint.h>
+#include <stddef.h>
 
-#include "list.h"
 #include "map.h"
 
 #include "vertex.h"
 #include "path.h"
 
 /**
- * Represents a linked list of struct wave
+ * Represents the index of a missing node, such as the parent of
+ * the root node.
  */
-typedef struct list wave_list;
+#define WAVE_NONE SIZE_MAX
 
 /**
- * Represents a wave from a graph.
- *
- * @member parent the parent wave, NULL if there is no
- * @member depth the wave depth
- * @member vertex the vertex of this wave
- * @member subwaves the underlying sub-waves
+ * Represents the length of sub-nodes from which a node looks
+ * them up in the index of the wave instead of walking them.
  */
-struct wave {
-    struct wave* parent;
+#define WAVE_INDEX_CHILDREN 8
 
-    size_t depth;
+/**
+ * Represents a node of a wave, the links are indices of the
+ * wave's nodes instead of pointers.
+ *
+ * @member vertex the vertex of this node
+ * @member depth the node depth, it's never greater than the
+ *               length of vertices
+ * @member parent the parent node, WAVE_NONE if there is no
+ * @member first_child the first sub-node, WAVE_NONE if there is
+ *                     no
+ * @member last_child the last sub-node, so a sub-node is added
+ *                    at the end without walking its siblings
+ * @member next_sibling the next sub-node of the parent,
+ *                      WAVE_NONE if there is no
+ * @member children the length of sub-nodes
+ */
+struct wave_node {
     vertex_t vertex;
+    vertex_t depth;
 
-    wave_list subwaves;
+    size_t parent;
+    size_t first_child;
+    size_t last_child;
+    size_t next_sibling;
+    size_t children;
 };
 
 /**
- * Represents a HashMap that links a vertex_t (the key) with a
- * struct wave (the value).
+ * Represents the waves from a graph, as a tree of nodes stored
+ * in a single growable block.
+ *
+ * The root node is the first one, and every node is added after
+ * its parent, so it's destroyed by a single free and a walk
+ * reads the nodes from a contiguous block.
  *
- * See in another way: HashMap<vertex_t, struct wave>
+ * The sub-nodes of a node with WAVE_INDEX_CHILDREN or more are
+ * also in an open-addressing table keyed by (parent, vertex),
+ * so adding or getting a sub-node takes O(1) time however many
+ * siblings it has.
  *
- * @see wave_destroyer
+ * @see wave_init
+ * @see wave_destroy
+ *
+ * @member len the length of nodes
+ * @member capacity the length of nodes that it can hold
+ * @member nodes the nodes, nodes[0] is the root node
+ * @member index the table of the indexed sub-nodes, WAVE_NONE if
+ *               the slot is free
+ * @member index_len the length of used slots
+ * @member index_capacity the length of slots, a power of two
  */
-typedef struct hashmap vtwave_map;
+struct wave {
+    size_t len;
+    size_t capacity;
+
+    struct wave_node* nodes;
+
+    size_t* index;
+    size_t index_len;
+    size_t index_capacity;
+};
 
 /**
- * Initialize a wave.
+ * Initialize a wave with a root node.
  *
  * @param wave the wave to initialize
- * @param parent the parent wave, NULL if there is no
- * @param vertex the vertex of this wave
+ * @param vertex the vertex of the root node
  */
-void wave_init(struct wave* wave, struct wave* parent, vertex_t vertex);
+void wave_init(struct wave* wave, vertex_t vertex);
 /**
  * Print in STDOUT a wave.
  *
  * @param wave the wave to print
  */
-void wave_print(struct wave* wave);
+void wave_print(const struct wave* wave);
 /**
  * Destroy an initialized wave.
  *
@@ -63,24 +104,27 @@ void wave_print(struct wave* wave);
 void wave_destroy(struct wave* wave);
 
 /**
- * Add a vertex in a wave.
+ * Add a vertex under a node of a wave.
  *
- * If a vertex is attempted to be added twice, it will be
- * ignored.
+ * If a vertex is attempted to be added twice under the same
+ * node, it will be ignored.
  *
  * @param wave the wave where to add the vertex in
+ * @param node the parent node
  * @param vertex the vertex to add
- * @return the sub-wave created by adding the vertex
+ * @return the sub-node of the vertex, WAVE_NONE if it couldn't
+ *         be added
  */
-struct wave* wave_add(struct wave* wave, vertex_t vertex);
+size_t wave_add(struct wave* wave, size_t node, vertex_t vertex);
 /**
- * Return the sub-wave of a vertex.
+ * Return the sub-node of a vertex.
  *
- * @param wave the wave where to get the sub-wave
+ * @param wave the wave where to get the sub-node
+ * @param node the parent node
  * @param vertex the vertex to look for
- * @return the vertex's sub-wave, NULL if it doesn't exist
+ * @return the vertex's sub-node, WAVE_NONE if it doesn't exist
  */
-struct wave* wave_get(struct wave* wave, vertex_t vertex);
+size_t wave_get(const struct wave* wave, size_t node, vertex_t vertex);
 
 /**
  * Transform a wave in all possible paths.
@@ -88,7 +132,7 @@ struct wave* wave_get(struct wave* wave, vertex_t vertex);
  * @param wave the wave to transform
  * @param out_map the generated paths
  */
-void wave_to_path(struct wave* wave, u32path_map* out_map);
+void wave_to_path(const struct wave* wave, u32path_map* out_map);
 
 /**
  * The value destructor of wave.
@@ -0,0 +1,100 @@
+#ifndef ED_WEIGHT_GUARD_HEADER
+#define ED_WEIGHT_GUARD_HEADER
+
+#include <stdint.h>
+#include <inttypes.h>
+#include <math.h>
+
+/*
+ * The type of the weights is picked at build time, so every
+ * cell of the storages takes just the space that the data
+ * needs:
+ *
+ *     WEIGHT_FLOAT=1      float weights
+ *     WEIGHT_BITS=8       uint8_t weights
+ *     WEIGHT_BITS=16      uint16_t weights
+ *     WEIGHT_BITS=32      int32_t weights (by default)
+ *     WEIGHT_BITS=64      int64_t weights
+ *
+ * The narrow weights are unsigned, so every weight below the
+ * sentinel (255 or 65535) fits.
+ */
+#ifndef WEIGHT_BITS
+#define WEIGHT_BITS 32
+#endif
+
+#ifndef WEIGHT_FLOAT
+#define WEIGHT_FLOAT 0
+#endif
+
+#if WEIGHT_FLOAT
+
+/**
+ * Represents the weight of an edge.
+ */
+typedef float weight_t;
+/**
+ * Represents the sum of weights along a path, it's wider than
+ * weight_t so it doesn't overflow.
+ */
+typedef double distance_t;
+
+/**
+ * Represents the value that indicates that there is no edge
+ * between two vertices.
+ */
+#define NONE_WEIGHT_VALUE INFINITY
+#define DISTANCE_MAX INFINITY
+
+#define WEIGHT_PRI "g"
+#define DISTANCE_PRI "g"
+
+#elif WEIGHT_BITS == 8
+
+typedef uint8_t weight_t;
+typedef int64_t distance_t;
+
+#define NONE_WEIGHT_VALUE UINT8_MAX
+#define DISTANCE_MAX INT64_MAX
+
+#define WEIGHT_PRI PRIu8
+#define DISTANCE_PRI PRId64
+
+#elif WEIGHT_BITS == 16
+
+typedef uint16_t weight_t;
+typedef int64_t distance_t;
+
+#define NONE_WEIGHT_VALUE UINT16_MAX
+#define DISTANCE_MAX INT64_MAX
+
+#define WEIGHT_PRI PRIu16
+#define DISTANCE_PRI PRId64
+
+#elif WEIGHT_BITS == 32
+
+typedef int32_t weight_t;
+typedef int64_t distance_t;
+
+#define NONE_WEIGHT_VALUE INT32_MAX
+#define DISTANCE_MAX INT64_MAX
+
+#define WEIGHT_PRI PRId32
+#define DISTANCE_PRI PRId64
+
+#elif WEIGHT_BITS == 64
+
+typedef int64_t weight_t;
+typedef int64_t distance_t;
+
+#define NONE_WEIGHT_VALUE INT64_MAX
+#define DISTANCE_MAX INT64_MAX
+
+#define WEIGHT_PRI PRId64
+#define DISTANCE_PRI PRId64
+
+#else
+#error "WEIGHT_BITS must be 8, 16, 32 or 64"
+#endif
+
+#endif // ED_WEIGHT_GUARD_HEADER
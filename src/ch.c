@@ -0,0 +1,677 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <ch.h>
+#include <graph.h>
+#include <bitset.h>
+
+/**
+ * Represents the arcs of a vertex while the hierarchy is being
+ * built, they're both the edges of the graph and the added
+ * shortcuts, to contracted vertices or not.
+ *
+ * @member len the length of arcs
+ * @member capacity the length of arcs that data can hold
+ * @member data the arcs
+ */
+struct gch_arcs {
+    size_t len;
+    size_t capacity;
+
+    struct gch_arc* data;
+};
+
+/**
+ * Represents the state to build a hierarchy.
+ *
+ * @member len the length of vertices
+ * @member lists the arcs of each vertex
+ * @member contracted a bitset of the contracted vertices
+ * @member deleted how many neighbors of each vertex were
+ *                 contracted
+ * @member neighbors the not contracted neighbors of the vertex
+ *                   that is being contracted
+ * @member distances the distance of each vertex in a witness
+ *                   search
+ * @member heap the queue of a witness search
+ * @member touched the vertices whose distance was set in a
+ *                 witness search
+ * @member touched_len the length of touched vertices
+ */
+struct gch_builder {
+    size_t len;
+    struct gch_arcs* lists;
+    uint64_t* contracted;
+    size_t* deleted;
+
+    struct gch_arcs neighbors;
+
+    distance_t* distances;
+    struct heap_vertex heap;
+    vertex_t* touched;
+    size_t touched_len;
+};
+
+/**
+ * Initialize the state to build a hierarchy with the edges of
+ * a graph.
+ *
+ * @param builder the state to initialize
+ * @param graph the graph to build from
+ * @return true if it could allocate the state, otherwise false
+ */
+static bool _gch_builder_init(struct gch_builder* builder, struct graph* graph);
+/**
+ * Destroy the state to build a hierarchy.
+ *
+ * @param builder the state to destroy
+ */
+static void _gch_builder_destroy(struct gch_builder* builder);
+/**
+ * Add an arc, if there is already an arc to the same vertex
+ * then it just keeps the lower weight.
+ *
+ * @param arcs the arcs where to add the arc
+ * @param arc the arc to add
+ */
+static void _gch_arcs_put(struct gch_arcs* arcs, struct gch_arc arc);
+/**
+ * Search the weakest paths from a vertex without going through
+ * another one, it's bounded by a distance and by
+ * GCH_WITNESS_SETTLED.
+ *
+ * The distances are kept until _gch_witness_reset.
+ *
+ * @param builder the state of the hierarchy
+ * @param source the source vertex
+ * @param skipped the vertex that is being contracted
+ * @param limit the distance where it stops at
+ */
+static void _gch_witness(struct gch_builder* builder, vertex_t source, vertex_t skipped, distance_t limit);
+/**
+ * Reset the distances of a witness search.
+ *
+ * @param builder the state of the hierarchy
+ */
+static void _gch_witness_reset(struct gch_builder* builder);
+/**
+ * Count the shortcuts that the contraction of a vertex needs,
+ * and add them if it isn't simulated.
+ *
+ * @param builder the state of the hierarchy
+ * @param vi the vertex to contract
+ * @param simulate if the shortcuts are just counted
+ * @return the length of shortcuts
+ */
+static size_t _gch_contract(struct gch_builder* builder, vertex_t vi, bool simulate);
+/**
+ * Compute the importance of a vertex, the less important ones
+ * are contracted first.
+ *
+ * @param builder the state of the hierarchy
+ * @param vi the vertex
+ * @return the importance
+ */
+static distance_t _gch_priority(struct gch_builder* builder, vertex_t vi);
+/**
+ * Compare two arcs by their vertex.
+ *
+ * @see qsort
+ */
+static int _gch_arc_cmp(const void* a, const void* b);
+/**
+ * Look for the arc between two vertices, it's in the run of
+ * the vertex of lower rank.
+ *
+ * @param ch the hierarchy where to look for
+ * @param vi a vertex
+ * @param wj another vertex
+ * @return the arc, NULL if there is no
+ */
+static const struct gch_arc* _gch_find(const struct gch* ch, vertex_t vi, vertex_t wj);
+/**
+ * Search up from both vertices until the weakest path where
+ * they meet can't be improved.
+ *
+ * @param ch the hierarchy to query
+ * @param start_vertex the source vertex
+ * @param end_vertex the destination vertex
+ * @param out_meet where it'll store the vertex of highest rank
+ *                 of the path
+ * @return the weight of the path, DISTANCE_MAX if there is no
+ */
+static distance_t _gch_search(struct gch* ch, vertex_t start_vertex, vertex_t end_vertex, vertex_t* out_meet);
+/**
+ * Reset the buffers of the previous query.
+ *
+ * @param ch the hierarchy to reset
+ */
+static void _gch_reset(struct gch* ch);
+/**
+ * Add the vertices of an arc at the end of a sequence, after
+ * unpacking its shortcuts, but the first vertex.
+ *
+ * @param ch the hierarchy where the arc is
+ * @param vi the vertex where the arc starts at
+ * @param wj the vertex where the arc ends at
+ * @param out the sequence where to add the vertices
+ */
+static void _gch_unpack(const struct gch* ch, vertex_t vi, vertex_t wj, struct vertex_array* out);
+/**
+ * Add a vertex at the end of a sequence, it grows
+ * geometrically.
+ *
+ * @param array the sequence where to add the vertex
+ * @param vertex the vertex to add
+ */
+static void _gch_append(struct vertex_array* array, vertex_t vertex);
+
+bool gch_init(struct gch* ch, struct graph* graph) {
+    if (ch == NULL || graph == NULL) {
+        return false;
+    }
+
+    memset(ch, 0, sizeof(struct gch));
+
+    struct gch_builder builder = {0};
+    if (!_gch_builder_init(&builder, graph)) {
+        return false;
+    }
+
+    size_t len = builder.len;
+
+    ch->len = len;
+    ch->ranks = malloc(sizeof(vertex_t) * (len + 1));
+    ch->offsets = calloc(len + 1, sizeof(size_t));
+    ch->touched = malloc(sizeof(vertex_t) * (2 * len + 2));
+
+    bool ready = ch->ranks != NULL && ch->offsets != NULL && ch->touched != NULL;
+
+    for (int side = 0; side < 2; side++) {
+        ch->distances[side] = malloc(sizeof(distance_t) * (len + 1));
+        ch->parents[side] = malloc(sizeof(vertex_t) * (len + 1));
+
+        ready = ready && ch->distances[side] != NULL && ch->parents[side] != NULL;
+        ready = ready && heap_vertex_init(&ch->heaps[side], len);
+    }
+
+    struct heap_vertex queue = {0};
+    if (!ready || !heap_vertex_init(&queue, len)) {
+        _gch_builder_destroy(&builder);
+        gch_destroy(ch);
+        return false;
+    }
+
+    for (vertex_t i = 0; i < len; i++) {
+        heap_vertex_push(&queue, i, _gch_priority(&builder, i));
+
+        ch->distances[0][i] = DISTANCE_MAX;
+        ch->distances[1][i] = DISTANCE_MAX;
+        ch->parents[0][i] = VERTEX_T_MAX;
+        ch->parents[1][i] = VERTEX_T_MAX;
+    }
+
+    vertex_t rank = 0;
+
+    while (!heap_vertex_empty(&queue)) {
+        vertex_t vi = heap_vertex_pop(&queue, NULL);
+
+        // the importance could be outdated by the previous
+        // contractions, so it's computed again (lazy update)
+        distance_t priority = _gch_priority(&builder, vi);
+        if (!heap_vertex_empty(&queue) && priority > heap_vertex_top(&queue)) {
+            heap_vertex_push(&queue, vi, priority);
+            continue;
+        }
+
+        _gch_contract(&builder, vi, false);
+
+        // keep just the arcs to the vertices that are not
+        // contracted yet, they have a higher rank
+        struct gch_arcs* arcs = &builder.lists[vi];
+        size_t kept = 0;
+
+        for (size_t k = 0; k < arcs->len; k++) {
+            vertex_t wj = arcs->data[k].vertex;
+            if (bitset_get(builder.contracted, wj)) {
+                continue;
+            }
+
+            arcs->data[kept++] = arcs->data[k];
+            builder.deleted[wj]++;
+        }
+
+        // a vertex without arcs never allocated its run
+        arcs->len = kept;
+        if (arcs->len > 0) {
+            qsort(arcs->data, arcs->len, sizeof(struct gch_arc), _gch_arc_cmp);
+        }
+
+        bitset_set(builder.contracted, vi);
+        ch->ranks[vi] = rank++;
+        ch->offsets[vi + 1] = kept;
+    }
+
+    heap_vertex_destroy(&queue);
+
+    // move the runs into a single array
+    for (size_t i = 0; i < len; i++) {
+        ch->offsets[i + 1] += ch->offsets[i];
+    }
+
+    ch->arcs = malloc(sizeof(struct gch_arc) * (ch->offsets[len] + 1));
+    if (ch->arcs == NULL) {
+        _gch_builder_destroy(&builder);
+        gch_destroy(ch);
+        return false;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        struct gch_arcs* arcs = &builder.lists[i];
+        if (arcs->len > 0) {
+            memcpy(&ch->arcs[ch->offsets[i]], arcs->data, sizeof(struct gch_arc) * arcs->len);
+        }
+    }
+
+    _gch_builder_destroy(&builder);
+    return true;
+}
+
+void gch_destroy(struct gch* ch) {
+    if (ch == NULL) {
+        return;
+    }
+
+    free(ch->ranks);
+    free(ch->offsets);
+    free(ch->arcs);
+    free(ch->touched);
+
+    for (int side = 0; side < 2; side++) {
+        free(ch->distances[side]);
+        free(ch->parents[side]);
+        heap_vertex_destroy(&ch->heaps[side]);
+    }
+
+    memset(ch, 0, sizeof(struct gch));
+}
+
+distance_t gch_distance(struct gch* ch, vertex_t start_vertex, vertex_t end_vertex) {
+    vertex_t meet = VERTEX_T_MAX;
+    return _gch_search(ch, start_vertex, end_vertex, &meet);
+}
+
+bool gch_path(struct gch* ch, vertex_t start_vertex, vertex_t end_vertex, struct path* out_path) {
+    if (out_path == NULL) {
+        return false;
+    }
+
+    vertex_t meet = VERTEX_T_MAX;
+    distance_t distance = _gch_search(ch, start_vertex, end_vertex, &meet);
+    if (distance == DISTANCE_MAX) {
+        return false;
+    }
+
+    // the vertices of the hierarchy from the source vertex up
+    // to the meeting one, they're walked backwards
+    struct vertex_array hops = {0};
+    for (vertex_t v = meet; v != VERTEX_T_MAX; v = ch->parents[0][v]) {
+        _gch_append(&hops, v);
+    }
+
+    struct vertex_array* vertices = &out_path->vertices;
+    vertices->len = 0;
+    _gch_append(vertices, start_vertex);
+
+    for (size_t k = hops.len - 1; k > 0; k--) {
+        _gch_unpack(ch, hops.data[k], hops.data[k - 1], vertices);
+    }
+
+    // the backward search goes down from the meeting vertex
+    // until the destination vertex
+    for (vertex_t v = meet; ch->parents[1][v] != VERTEX_T_MAX; v = ch->parents[1][v]) {
+        _gch_unpack(ch, v, ch->parents[1][v], vertices);
+    }
+
+    out_path->weight = distance;
+
+    vertex_array_destroy(&hops);
+    return true;
+}
+
+static bool _gch_builder_init(struct gch_builder* builder, struct graph* graph) {
+    size_t len = graph->len;
+
+    builder->len = len;
+    builder->lists = calloc(len + 1, sizeof(struct gch_arcs));
+    builder->contracted = calloc(bitset_words(len) + 1, sizeof(uint64_t));
+    builder->deleted = calloc(len + 1, sizeof(size_t));
+    builder->distances = malloc(sizeof(distance_t) * (len + 1));
+    builder->touched = malloc(sizeof(vertex_t) * (len + 1));
+
+    if (builder->lists == NULL || builder->contracted == NULL || builder->deleted == NULL
+        || builder->distances == NULL || builder->touched == NULL || !heap_vertex_init(&builder->heap, len)) {
+        _gch_builder_destroy(builder);
+        return false;
+    }
+
+    for (vertex_t i = 0; i < len; i++) {
+        builder->distances[i] = DISTANCE_MAX;
+
+        struct gneighbor_iterator it = {0};
+        graph_neighbors(graph, i, &it);
+
+        weight_t weight = 0;
+        for (vertex_t j = 0; gneighbor_next(&it, &j, &weight);) {
+            // a loop is never in a weakest path
+            if (j == i) {
+                continue;
+            }
+
+            _gch_arcs_put(&builder->lists[i], (struct gch_arc) {j, VERTEX_T_MAX, weight});
+        }
+    }
+
+    return true;
+}
+
+static void _gch_builder_destroy(struct gch_builder* builder) {
+    for (size_t i = 0; builder->lists != NULL && i < builder->len; i++) {
+        free(builder->lists[i].data);
+    }
+
+    free(builder->lists);
+    free(builder->contracted);
+    free(builder->deleted);
+    free(builder->neighbors.data);
+    free(builder->distances);
+    free(builder->touched);
+    heap_vertex_destroy(&builder->heap);
+
+    memset(builder, 0, sizeof(struct gch_builder));
+}
+
+static void _gch_arcs_put(struct gch_arcs* arcs, struct gch_arc arc) {
+    for (size_t k = 0; k < arcs->len; k++) {
+        if (arcs->data[k].vertex == arc.vertex) {
+            if (arc.weight < arcs->data[k].weight) {
+                arcs->data[k] = arc;
+            }
+
+            return;
+        }
+    }
+
+    if (arcs->len >= arcs->capacity) {
+        size_t capacity = arcs->capacity > 0 ? arcs->capacity * 2 : 4;
+        struct gch_arc* data = realloc(arcs->data, sizeof(struct gch_arc) * capacity);
+        if (data == NULL) {
+            return;
+        }
+
+        arcs->capacity = capacity;
+        arcs->data = data;
+    }
+
+    arcs->data[arcs->len++] = arc;
+}
+
+static void _gch_witness(struct gch_builder* builder, vertex_t source, vertex_t skipped, distance_t limit) {
+    distance_t* distances = builder->distances;
+
+    distances[source] = 0;
+    builder->touched[builder->touched_len++] = source;
+    heap_vertex_push(&builder->heap, source, 0);
+
+    size_t settled = 0;
+
+    while (!heap_vertex_empty(&builder->heap) && settled < GCH_WITNESS_SETTLED) {
+        distance_t key = 0;
+        vertex_t i = heap_vertex_pop(&builder->heap, &key);
+        if (key > limit) {
+            break;
+        }
+
+        settled++;
+
+        struct gch_arcs* arcs = &builder->lists[i];
+        for (size_t k = 0; k < arcs->len; k++) {
+            vertex_t j = arcs->data[k].vertex;
+            if (j == skipped || bitset_get(builder->contracted, j)) {
+                continue;
+            }
+
+            distance_t distance = key + arcs->data[k].weight;
+            if (distance < distances[j]) {
+                if (distances[j] == DISTANCE_MAX) {
+                    builder->touched[builder->touched_len++] = j;
+                }
+
+                distances[j] = distance;
+                heap_vertex_push(&builder->heap, j, distance);
+            }
+        }
+    }
+}
+
+static void _gch_witness_reset(struct gch_builder* builder) {
+    while (!heap_vertex_empty(&builder->heap)) {
+        heap_vertex_pop(&builder->heap, NULL);
+    }
+
+    for (size_t k = 0; k < builder->touched_len; k++) {
+        builder->distances[builder->touched[k]] = DISTANCE_MAX;
+    }
+
+    builder->touched_len = 0;
+}
+
+static size_t _gch_contract(struct gch_builder* builder, vertex_t vi, bool simulate) {
+    // collect the neighbors first, the shortcuts are added in
+    // their arcs while they're visited
+    struct gch_arcs* neighbors = &builder->neighbors;
+    neighbors->len = 0;
+
+    struct gch_arcs* arcs = &builder->lists[vi];
+    for (size_t k = 0; k < arcs->len; k++) {
+        if (!bitset_get(builder->contracted, arcs->data[k].vertex)) {
+            _gch_arcs_put(neighbors, arcs->data[k]);
+        }
+    }
+
+    size_t shortcuts = 0;
+
+    for (size_t a = 0; a < neighbors->len; a++) {
+        struct gch_arc from = neighbors->data[a];
+
+        // a path through vi to any other neighbor is at most
+        // as heavy as the limit
+        distance_t limit = 0;
+        for (size_t b = a + 1; b < neighbors->len; b++) {
+            distance_t via = from.weight + neighbors->data[b].weight;
+            limit = via > limit ? via : limit;
+        }
+
+        if (a + 1 >= neighbors->len) {
+            break;
+        }
+
+        _gch_witness(builder, from.vertex, vi, limit);
+
+        for (size_t b = a + 1; b < neighbors->len; b++) {
+            struct gch_arc to = neighbors->data[b];
+            distance_t via = from.weight + to.weight;
+
+            // there is a path as weak without vi
+            if (builder->distances[to.vertex] <= via) {
+                continue;
+            }
+
+            shortcuts++;
+            if (!simulate) {
+                _gch_arcs_put(&builder->lists[from.vertex], (struct gch_arc) {to.vertex, vi, via});
+                _gch_arcs_put(&builder->lists[to.vertex], (struct gch_arc) {from.vertex, vi, via});
+            }
+        }
+
+        _gch_witness_reset(builder);
+    }
+
+    return shortcuts;
+}
+
+static distance_t _gch_priority(struct gch_builder* builder, vertex_t vi) {
+    size_t degree = 0;
+
+    struct gch_arcs* arcs = &builder->lists[vi];
+    for (size_t k = 0; k < arcs->len; k++) {
+        degree += !bitset_get(builder->contracted, arcs->data[k].vertex);
+    }
+
+    // the edge difference, plus the contracted neighbors to
+    // spread the contractions uniformly
+    distance_t shortcuts = _gch_contract(builder, vi, true);
+    return shortcuts - (distance_t) degree + (distance_t) builder->deleted[vi];
+}
+
+static int _gch_arc_cmp(const void* a, const void* b) {
+    const struct gch_arc* arc_a = a;
+    const struct gch_arc* arc_b = b;
+
+    return (arc_a->vertex > arc_b->vertex) - (arc_a->vertex < arc_b->vertex);
+}
+
+static const struct gch_arc* _gch_find(const struct gch* ch, vertex_t vi, vertex_t wj) {
+    if (ch->ranks[vi] > ch->ranks[wj]) {
+        vertex_t swap = vi;
+        vi = wj;
+        wj = swap;
+    }
+
+    // the runs are sorted by vertex
+    size_t low = ch->offsets[vi];
+    size_t high = ch->offsets[vi + 1];
+
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        vertex_t vertex = ch->arcs[middle].vertex;
+
+        if (vertex == wj) {
+            return &ch->arcs[middle];
+        }
+
+        if (vertex < wj) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return NULL;
+}
+
+static distance_t _gch_search(struct gch* ch, vertex_t start_vertex, vertex_t end_vertex, vertex_t* out_meet) {
+    if (ch == NULL || start_vertex >= ch->len || end_vertex >= ch->len) {
+        return DISTANCE_MAX;
+    }
+
+    _gch_reset(ch);
+
+    vertex_t sources[2] = {start_vertex, end_vertex};
+    for (int side = 0; side < 2; side++) {
+        ch->distances[side][sources[side]] = 0;
+        ch->parents[side][sources[side]] = VERTEX_T_MAX;
+        ch->touched[ch->touched_len++] = sources[side];
+
+        heap_vertex_push(&ch->heaps[side], sources[side], 0);
+    }
+
+    distance_t best = DISTANCE_MAX;
+    *out_meet = VERTEX_T_MAX;
+
+    for (;;) {
+        distance_t forward_key = heap_vertex_top(&ch->heaps[0]);
+        distance_t backward_key = heap_vertex_top(&ch->heaps[1]);
+
+        int side = forward_key <= backward_key ? 0 : 1;
+        distance_t key = side == 0 ? forward_key : backward_key;
+
+        // both searches are empty or they can't improve the
+        // weakest path found
+        if (key == DISTANCE_MAX || key >= best) {
+            break;
+        }
+
+        distance_t* distances = ch->distances[side];
+        const distance_t* other_distances = ch->distances[1 - side];
+
+        vertex_t i = heap_vertex_pop(&ch->heaps[side], NULL);
+
+        if (other_distances[i] != DISTANCE_MAX && key + other_distances[i] < best) {
+            best = key + other_distances[i];
+            *out_meet = i;
+        }
+
+        for (size_t k = ch->offsets[i]; k < ch->offsets[i + 1]; k++) {
+            const struct gch_arc* arc = &ch->arcs[k];
+            vertex_t j = arc->vertex;
+            distance_t distance = key + arc->weight;
+
+            if (distance < distances[j]) {
+                // a vertex can be touched by both searches,
+                // it's reset twice
+                if (distances[j] == DISTANCE_MAX) {
+                    ch->touched[ch->touched_len++] = j;
+                }
+
+                distances[j] = distance;
+                ch->parents[side][j] = i;
+                heap_vertex_push(&ch->heaps[side], j, distance);
+            }
+        }
+    }
+
+    return best;
+}
+
+static void _gch_reset(struct gch* ch) {
+    for (int side = 0; side < 2; side++) {
+        while (!heap_vertex_empty(&ch->heaps[side])) {
+            heap_vertex_pop(&ch->heaps[side], NULL);
+        }
+    }
+
+    for (size_t k = 0; k < ch->touched_len; k++) {
+        vertex_t v = ch->touched[k];
+
+        ch->distances[0][v] = DISTANCE_MAX;
+        ch->distances[1][v] = DISTANCE_MAX;
+        ch->parents[0][v] = VERTEX_T_MAX;
+        ch->parents[1][v] = VERTEX_T_MAX;
+    }
+
+    ch->touched_len = 0;
+}
+
+static void _gch_unpack(const struct gch* ch, vertex_t vi, vertex_t wj, struct vertex_array* out) {
+    const struct gch_arc* arc = _gch_find(ch, vi, wj);
+
+    if (arc == NULL || arc->middle == VERTEX_T_MAX) {
+        _gch_append(out, wj);
+        return;
+    }
+
+    // a shortcut skips its middle vertex, which has a lower
+    // rank than both ends
+    vertex_t middle = arc->middle;
+    _gch_unpack(ch, vi, middle, out);
+    _gch_unpack(ch, middle, wj, out);
+}
+
+static void _gch_append(struct vertex_array* array, vertex_t vertex) {
+    if (array->len >= array->capacity) {
+        vertex_array_reserve(array, array->capacity > 0 ? array->capacity : 16);
+    }
+
+    array->data[array->len++] = vertex;
+}
@@ -0,0 +1,299 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <csr.h>
+#include <graph.h>
+
+/**
+ * Represents an entry of a row while the adjacency is being
+ * built.
+ *
+ * @member vertex the neighbor vertex
+ * @member order the position of the edge in the edge list
+ * @member weight the edge's weight
+ */
+struct gcsr_entry {
+    vertex_t vertex;
+    size_t order;
+    weight_t weight;
+};
+
+/**
+ * Compare two entries of a row by their vertex and then by
+ * their order in the edge list.
+ *
+ * @see qsort
+ */
+static int _gcsr_entry_cmp(const void* a, const void* b);
+/**
+ * Reserve space for at least one more neighbor.
+ *
+ * @param csr the adjacency to reserve space
+ */
+static void _gcsr_reserve(struct gcsr* csr);
+
+void gcsr_init(struct gcsr* csr,
+               bool weighted,
+               size_t len,
+               const struct edge* edges,
+               size_t edge_len) {
+    if (csr == NULL) {
+        return;
+    }
+
+    gcsr_destroy(csr);
+
+    if (edges == NULL) {
+        edge_len = 0;
+    }
+
+    weight_t empty_weight = weighted ? NONE_WEIGHT_VALUE : 0;
+
+    // count how many entries each row will have, an edge
+    // <vi, wj> is stored in both rows unless it is a loop
+    size_t* starts = calloc(len + 1, sizeof(size_t));
+    for (size_t k = 0; k < edge_len; k++) {
+        const struct edge* edge = &edges[k];
+        if (edge->vi >= len || edge->wj >= len) {
+            continue;
+        }
+
+        starts[edge->vi + 1]++;
+        if (edge->vi != edge->wj) {
+            starts[edge->wj + 1]++;
+        }
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        starts[i + 1] += starts[i];
+    }
+
+    // distribute the entries in their rows keeping the order
+    // of the edge list
+    size_t entry_len = starts[len];
+    struct gcsr_entry* entries = malloc(sizeof(struct gcsr_entry) * (entry_len + 1));
+    size_t* cursor = malloc(sizeof(size_t) * (len + 1));
+    memcpy(cursor, starts, sizeof(size_t) * (len + 1));
+
+    for (size_t k = 0; k < edge_len; k++) {
+        const struct edge* edge = &edges[k];
+        if (edge->vi >= len || edge->wj >= len) {
+            continue;
+        }
+
+        entries[cursor[edge->vi]++] = (struct gcsr_entry) {edge->wj, k, edge->weight};
+        if (edge->vi != edge->wj) {
+            entries[cursor[edge->wj]++] = (struct gcsr_entry) {edge->vi, k, edge->weight};
+        }
+    }
+
+    free(cursor);
+
+    csr->len = len;
+    csr->reserved = len;
+    csr->capacity = entry_len;
+    csr->offsets = malloc(sizeof(size_t) * (len + 1));
+    csr->neighbors = malloc(sizeof(vertex_t) * (entry_len + 1));
+    csr->weights = malloc(sizeof(weight_t) * (entry_len + 1));
+
+    // sort each row and keep just the last repeated edge,
+    // such as graph_addw would have done
+    size_t next = 0;
+    for (vertex_t i = 0; i < len; i++) {
+        csr->offsets[i] = next;
+
+        struct gcsr_entry* row = &entries[starts[i]];
+        size_t row_len = starts[i + 1] - starts[i];
+        qsort(row, row_len, sizeof(struct gcsr_entry), _gcsr_entry_cmp);
+
+        for (size_t k = 0; k < row_len; k++) {
+            if (k + 1 < row_len && row[k + 1].vertex == row[k].vertex) {
+                continue;
+            }
+
+            weight_t weight = row[k].weight;
+            if (weight == empty_weight) {
+                continue;
+            }
+            if (!weighted) {
+                weight = 1;
+            }
+
+            csr->neighbors[next] = row[k].vertex;
+            csr->weights[next] = weight;
+            next++;
+        }
+    }
+    csr->offsets[len] = next;
+
+    free(entries);
+    free(starts);
+}
+
+void gcsr_destroy(struct gcsr* csr) {
+    if (csr == NULL) {
+        return;
+    }
+
+    free(csr->offsets);
+    free(csr->neighbors);
+    free(csr->weights);
+
+    csr->len = 0;
+    csr->reserved = 0;
+    csr->capacity = 0;
+    csr->offsets = NULL;
+    csr->neighbors = NULL;
+    csr->weights = NULL;
+}
+
+bool gcsr_reserve(struct gcsr* csr, size_t reserved) {
+    if (csr == NULL) {
+        return false;
+    }
+    if (csr->offsets != NULL && reserved <= csr->reserved) {
+        return true;
+    }
+
+    size_t* new_offsets = realloc(csr->offsets, sizeof(size_t) * (reserved + 1));
+    if (new_offsets == NULL) {
+        return false;
+    }
+
+    // an adjacency without vertices still has the end offset
+    if (csr->offsets == NULL) {
+        new_offsets[0] = 0;
+    }
+
+    csr->offsets = new_offsets;
+    csr->reserved = reserved;
+    return true;
+}
+
+vertex_t gcsr_add_vertex(struct gcsr* csr) {
+    if (csr == NULL) {
+        return VERTEX_T_MAX;
+    }
+
+    if (csr->offsets == NULL || csr->len >= csr->reserved) {
+        size_t reserved = csr->reserved > 0 ? csr->reserved * 2 : 16;
+        if (!gcsr_reserve(csr, reserved)) {
+            return VERTEX_T_MAX;
+        }
+    }
+
+    // the new vertex has an empty run at the end
+    vertex_t vertex = csr->len++;
+    csr->offsets[csr->len] = csr->offsets[vertex];
+
+    return vertex;
+}
+
+bool gcsr_find(const struct gcsr* csr, vertex_t vi, vertex_t wj, size_t* out_pos) {
+    size_t low = csr->offsets[vi];
+    size_t high = csr->offsets[vi + 1];
+
+    // lower bound of wj in the sorted run of vi
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+
+        if (csr->neighbors[mid] < wj) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (out_pos != NULL) {
+        *out_pos = low;
+    }
+
+    return low < csr->offsets[vi + 1] && csr->neighbors[low] == wj;
+}
+
+bool gcsr_set(struct gcsr* csr, vertex_t vi, vertex_t wj, weight_t weight) {
+    if (csr == NULL || vi >= csr->len || wj >= csr->len) {
+        return false;
+    }
+
+    size_t pos = 0;
+    if (gcsr_find(csr, vi, wj, &pos)) {
+        csr->weights[pos] = weight;
+        return true;
+    }
+
+    _gcsr_reserve(csr);
+    if (csr->capacity <= csr->offsets[csr->len]) {
+        return false;
+    }
+
+    // shift the following runs to open a hole in pos
+    size_t tail = csr->offsets[csr->len] - pos;
+    memmove(&csr->neighbors[pos + 1], &csr->neighbors[pos], sizeof(vertex_t) * tail);
+    memmove(&csr->weights[pos + 1], &csr->weights[pos], sizeof(weight_t) * tail);
+
+    csr->neighbors[pos] = wj;
+    csr->weights[pos] = weight;
+
+    for (vertex_t i = vi + 1; i <= csr->len; i++) {
+        csr->offsets[i]++;
+    }
+
+    return true;
+}
+
+void gcsr_del(struct gcsr* csr, vertex_t vi, vertex_t wj) {
+    if (csr == NULL || vi >= csr->len || wj >= csr->len) {
+        return;
+    }
+
+    size_t pos = 0;
+    if (!gcsr_find(csr, vi, wj, &pos)) {
+        return;
+    }
+
+    size_t tail = csr->offsets[csr->len] - pos - 1;
+    memmove(&csr->neighbors[pos], &csr->neighbors[pos + 1], sizeof(vertex_t) * tail);
+    memmove(&csr->weights[pos], &csr->weights[pos + 1], sizeof(weight_t) * tail);
+
+    for (vertex_t i = vi + 1; i <= csr->len; i++) {
+        csr->offsets[i]--;
+    }
+}
+
+static int _gcsr_entry_cmp(const void* a, const void* b) {
+    const struct gcsr_entry* entry_a = a;
+    const struct gcsr_entry* entry_b = b;
+
+    if (entry_a->vertex != entry_b->vertex) {
+        return entry_a->vertex < entry_b->vertex ? -1 : 1;
+    }
+    if (entry_a->order != entry_b->order) {
+        return entry_a->order < entry_b->order ? -1 : 1;
+    }
+
+    return 0;
+}
+
+static void _gcsr_reserve(struct gcsr* csr) {
+    size_t used = csr->offsets[csr->len];
+    if (csr->capacity > used) {
+        return;
+    }
+
+    size_t new_cap = csr->capacity > 0 ? csr->capacity * 2 : 16;
+
+    vertex_t* new_neighbors = realloc(csr->neighbors, sizeof(vertex_t) * new_cap);
+    if (new_neighbors != NULL) {
+        csr->neighbors = new_neighbors;
+    }
+
+    weight_t* new_weights = realloc(csr->weights, sizeof(weight_t) * new_cap);
+    if (new_weights != NULL) {
+        csr->weights = new_weights;
+    }
+
+    if (new_neighbors != NULL && new_weights != NULL) {
+        csr->capacity = new_cap;
+    }
+}
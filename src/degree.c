@@ -0,0 +1,192 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <degree.h>
+
+/**
+ * Swap two positions of the order of vertices.
+ *
+ * @param degree the degrees where to swap
+ * @param a the first position
+ * @param b the second position
+ */
+static inline void _gdegree_swap(struct gdegree* degree, size_t a, size_t b);
+
+void gdegree_init(struct gdegree* degree, size_t len, const size_t* degrees) {
+    if (degree == NULL) {
+        return;
+    }
+
+    gdegree_destroy(degree);
+
+    if (!gdegree_reserve(degree, len)) {
+        return;
+    }
+
+    degree->len = len;
+    degree->top = 0;
+
+    for (vertex_t i = 0; i < len; i++) {
+        size_t d = degrees != NULL ? degrees[i] : 0;
+        degree->degrees[i] = d;
+
+        if (d > degree->top) {
+            degree->top = d;
+        }
+    }
+
+    // count the vertices of each degree, then every bucket
+    // starts where the previous one ends
+    size_t* starts = degree->starts;
+    memset(starts, 0, sizeof(size_t) * (degree->top + 2));
+
+    for (vertex_t i = 0; i < len; i++) {
+        starts[degree->degrees[i] + 1]++;
+    }
+    for (size_t d = 1; d <= degree->top + 1; d++) {
+        starts[d] += starts[d - 1];
+    }
+
+    // place the vertices in ascending order inside its bucket,
+    // the start of each bucket is used as cursor and then it's
+    // restored from the previous one
+    for (vertex_t i = 0; i < len; i++) {
+        size_t pos = starts[degree->degrees[i]]++;
+
+        degree->order[pos] = i;
+        degree->positions[i] = pos;
+    }
+    for (size_t d = degree->top + 1; d > 0; d--) {
+        starts[d] = starts[d - 1];
+    }
+    starts[0] = 0;
+}
+
+void gdegree_destroy(struct gdegree* degree) {
+    if (degree == NULL) {
+        return;
+    }
+
+    free(degree->degrees);
+    free(degree->order);
+    free(degree->positions);
+    free(degree->starts);
+
+    degree->len = 0;
+    degree->capacity = 0;
+    degree->top = 0;
+    degree->degrees = NULL;
+    degree->order = NULL;
+    degree->positions = NULL;
+    degree->starts = NULL;
+}
+
+bool gdegree_reserve(struct gdegree* degree, size_t capacity) {
+    if (degree == NULL) {
+        return false;
+    }
+    if (degree->starts != NULL && capacity <= degree->capacity) {
+        return true;
+    }
+
+    size_t* degrees = realloc(degree->degrees, sizeof(size_t) * (capacity + 1));
+    if (degrees == NULL) {
+        return false;
+    }
+    degree->degrees = degrees;
+
+    vertex_t* order = realloc(degree->order, sizeof(vertex_t) * (capacity + 1));
+    if (order == NULL) {
+        return false;
+    }
+    degree->order = order;
+
+    size_t* positions = realloc(degree->positions, sizeof(size_t) * (capacity + 1));
+    if (positions == NULL) {
+        return false;
+    }
+    degree->positions = positions;
+
+    // a vertex can have a loop, so its degree can be as high as
+    // the length of vertices
+    size_t* starts = realloc(degree->starts, sizeof(size_t) * (capacity + 2));
+    if (starts == NULL) {
+        return false;
+    }
+
+    // the buckets of a new one are empty
+    if (degree->starts == NULL) {
+        starts[0] = 0;
+        starts[1] = 0;
+    }
+    degree->starts = starts;
+
+    degree->capacity = capacity;
+    return true;
+}
+
+void gdegree_add_vertex(struct gdegree* degree) {
+    if (degree == NULL) {
+        return;
+    }
+    if (degree->len >= degree->capacity && !gdegree_reserve(degree, degree->len * 2 + 1)) {
+        return;
+    }
+
+    vertex_t vi = degree->len;
+
+    degree->degrees[vi] = 0;
+    degree->order[vi] = vi;
+    degree->positions[vi] = vi;
+
+    // the vertex is at the end of the highest bucket, so it's
+    // moved down to the bucket 0 swapping it with the first
+    // vertex of every bucket
+    for (size_t d = degree->top; d > 0; d--) {
+        _gdegree_swap(degree, degree->starts[d], degree->positions[vi]);
+        degree->starts[d]++;
+    }
+
+    degree->len++;
+    degree->starts[degree->top + 1] = degree->len;
+}
+
+void gdegree_inc(struct gdegree* degree, vertex_t vi) {
+    size_t d = degree->degrees[vi];
+
+    // a bucket above the top one must be covered
+    if (d + 1 > degree->top) {
+        degree->top = d + 1;
+        degree->starts[degree->top + 1] = degree->len;
+    }
+
+    // the vertex is moved at the end of its bucket, which
+    // becomes the start of the next bucket
+    size_t last = degree->starts[d + 1] - 1;
+    _gdegree_swap(degree, degree->positions[vi], last);
+
+    degree->starts[d + 1]--;
+    degree->degrees[vi]++;
+}
+
+void gdegree_dec(struct gdegree* degree, vertex_t vi) {
+    size_t d = degree->degrees[vi];
+
+    // the vertex is moved at the start of its bucket, which
+    // becomes the end of the previous bucket
+    size_t first = degree->starts[d];
+    _gdegree_swap(degree, degree->positions[vi], first);
+
+    degree->starts[d]++;
+    degree->degrees[vi]--;
+}
+
+static inline void _gdegree_swap(struct gdegree* degree, size_t a, size_t b) {
+    vertex_t va = degree->order[a];
+    vertex_t vb = degree->order[b];
+
+    degree->order[a] = vb;
+    degree->order[b] = va;
+    degree->positions[vb] = a;
+    degree->positions[va] = b;
+}
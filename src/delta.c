@@ -0,0 +1,565 @@
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include <graph.h>
+#include <bitset.h>
+
+/**
+ * Represents a relaxation of an edge that is sent to the thread
+ * that owns the destination vertex.
+ *
+ * @member vertex the destination vertex
+ * @member parent the vertex where the edge starts at
+ * @member distance the distance through the edge
+ * @member strict if the parent is at a lower distance, it's not
+ *                for a zero weight edge
+ */
+struct gdelta_request {
+    vertex_t vertex;
+    vertex_t parent;
+    distance_t distance;
+    bool strict;
+};
+
+/**
+ * Represents a sequence of relaxations.
+ *
+ * @member len the length of relaxations
+ * @member capacity the length of relaxations that it can hold
+ * @member data the relaxations
+ */
+struct gdelta_requests {
+    size_t len;
+    size_t capacity;
+
+    struct gdelta_request* data;
+};
+
+/**
+ * Represents the state of a thread, it owns the vertices v
+ * where v % threads is its ID and just it modifies them.
+ *
+ * @member id the ID of the thread
+ * @member buckets the owned vertices by bucket, a ring of
+ *                 gdelta_state.ring buckets where the bucket b
+ *                 is at b % ring; a vertex can be in a later
+ *                 bucket after its distance decreased
+ * @member frontier the owned vertices taken from the actual
+ *                  bucket to relax their light edges
+ * @member settled the owned vertices taken from the actual
+ *                 bucket, to relax their heavy edges
+ * @member outboxes the relaxations to send to each thread
+ * @member active if the frontier is not empty
+ * @member next the lowest bucket after the actual one that is
+ *              not empty, SIZE_MAX if there is no
+ * @member failed if it couldn't allocate memory
+ */
+struct gdelta_worker {
+    size_t id;
+
+    struct vertex_array* buckets;
+    struct vertex_array frontier;
+    struct vertex_array settled;
+    struct gdelta_requests* outboxes;
+
+    bool active;
+    size_t next;
+    bool failed;
+};
+
+/**
+ * Represents the state shared by all the threads.
+ *
+ * @member graph the graph to search
+ * @member end_vertex the vertex where it stops, VERTEX_T_MAX to
+ *                    search all of them
+ * @member delta the width of a bucket
+ * @member ring the length of buckets of a thread, the queued
+ *             distances are at most the heaviest edge ahead of
+ *             the actual bucket, so they never wrap around
+ * @member threads the length of threads
+ * @member tree the distances and the parents of the vertices
+ * @member strict if the parent of each vertex is at a lower
+ *                distance
+ * @member in_bucket the bucket where each vertex is, SIZE_MAX
+ *                   if it isn't in any
+ * @member taken if each vertex was taken from the actual bucket
+ * @member workers the state of each thread
+ * @member barrier where the threads wait between phases
+ * @member gate where the created threads wait until all of
+ *              them were created
+ * @member gate_cond the condition to open the gate
+ * @member gate_state 0 while the gate is closed, 1 to run and
+ *                   -1 to give up because a thread couldn't be
+ *                   created
+ */
+struct gdelta_state {
+    struct graph* graph;
+    vertex_t end_vertex;
+    distance_t delta;
+    size_t ring;
+    size_t threads;
+
+    struct sssp_tree* tree;
+    bool* strict;
+    size_t* in_bucket;
+    bool* taken;
+
+    struct gdelta_worker* workers;
+    pthread_barrier_t barrier;
+
+    pthread_mutex_t gate;
+    pthread_cond_t gate_cond;
+    int gate_state;
+};
+
+/**
+ * Represents the arguments of a thread.
+ *
+ * @member state the shared state
+ * @member worker the state of the thread
+ */
+struct gdelta_task {
+    struct gdelta_state* state;
+    struct gdelta_worker* worker;
+};
+
+/**
+ * Run the search in a thread, all the threads take the same
+ * steps and they wait for each other between them.
+ *
+ * @param arg the task of the thread
+ * @return NULL
+ */
+static void* _gdelta_run(void* arg);
+/**
+ * Send the relaxations of the light or the heavy edges of some
+ * vertices to the threads that own the neighbors.
+ *
+ * @param state the shared state
+ * @param worker the state of the thread
+ * @param vertices the vertices whose edges are relaxed
+ * @param light true for the light edges, otherwise the heavy
+ */
+static void _gdelta_request(struct gdelta_state* state,
+                            struct gdelta_worker* worker,
+                            const struct vertex_array* vertices,
+                            bool light);
+/**
+ * Apply the relaxations that were sent to a thread.
+ *
+ * A tie keeps the lowest parent from a lower distance, such as
+ * graph_sssp, so the tree doesn't depend on the length of
+ * threads nor their order.
+ *
+ * @param state the shared state
+ * @param worker the state of the thread
+ */
+static void _gdelta_relax(struct gdelta_state* state, struct gdelta_worker* worker);
+/**
+ * Add a vertex into a bucket of a thread.
+ *
+ * @param state the shared state
+ * @param worker the state of the thread
+ * @param vertex the vertex to add
+ * @param bucket the bucket where to add it, it's less than ring
+ *               buckets ahead of the actual one
+ */
+static void _gdelta_bucket_add(struct gdelta_state* state, struct gdelta_worker* worker, vertex_t vertex, size_t bucket);
+/**
+ * Add a vertex at the end of a sequence, it grows
+ * geometrically.
+ *
+ * @param worker the state of the thread, it's marked if it
+ *               couldn't grow
+ * @param array the sequence where to add the vertex
+ * @param vertex the vertex to add
+ */
+static void _gdelta_append(struct gdelta_worker* worker, struct vertex_array* array, vertex_t vertex);
+/**
+ * Return the bucket of a distance.
+ *
+ * @param state the shared state
+ * @param distance the distance
+ * @return the bucket
+ */
+static inline size_t _gdelta_bucket(const struct gdelta_state* state, distance_t distance) {
+    return (size_t) (distance / state->delta);
+}
+/**
+ * Return the length of buckets that a thread needs, a relaxation
+ * reaches at most ceil(max_weight / delta) buckets ahead.
+ *
+ * @param max_weight the heaviest weight of the graph
+ * @param delta the width of a bucket
+ * @return the length of buckets
+ */
+static inline size_t _gdelta_ring(distance_t max_weight, distance_t delta) {
+#if WEIGHT_FLOAT
+    // the truncated quotient plus one is at least the ceiling,
+    // and the rounded sums can land a bucket further
+    return (size_t) (max_weight / delta) + 2;
+#else
+    return (size_t) ((max_weight + delta - 1) / delta) + 1;
+#endif
+}
+
+void graph_sssp_delta(struct graph* graph,
+                      vertex_t start_vertex,
+                      vertex_t end_vertex,
+                      distance_t delta,
+                      size_t threads,
+                      struct sssp_tree* out_tree) {
+    if (out_tree == NULL) {
+        return;
+    }
+
+    *out_tree = (struct sssp_tree) {0};
+    if (graph == NULL || start_vertex >= graph->len
+        || (graph->removed != NULL && bitset_get(graph->removed, start_vertex))) {
+        return;
+    }
+
+    size_t vertex_len = graph->len;
+
+    // a bucket as wide as the heaviest edge makes every edge
+    // light, so a bucket is settled by a few parallel rounds
+    if (delta <= 0) {
+        delta = graph->max_weight > 0 ? graph->max_weight : 1;
+    }
+
+    distance_t max_weight = graph->max_weight > 0 ? graph->max_weight : 0;
+
+    if (threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (size_t) online : 1;
+    }
+
+    if (!sssp_tree_init(out_tree, vertex_len, start_vertex)) {
+        return;
+    }
+
+    struct gdelta_state state = {
+        .graph = graph,
+        .end_vertex = end_vertex,
+        .delta = delta,
+        .ring = _gdelta_ring(max_weight, delta),
+        .threads = threads,
+        .tree = out_tree,
+        .strict = calloc(vertex_len, sizeof(bool)),
+        .in_bucket = malloc(sizeof(size_t) * vertex_len),
+        .taken = calloc(vertex_len, sizeof(bool)),
+        .workers = calloc(threads, sizeof(struct gdelta_worker)),
+        .gate = PTHREAD_MUTEX_INITIALIZER,
+        .gate_cond = PTHREAD_COND_INITIALIZER,
+        .gate_state = 0,
+    };
+
+    bool ready = state.strict != NULL && state.in_bucket != NULL && state.taken != NULL && state.workers != NULL;
+
+    for (size_t t = 0; ready && t < threads; t++) {
+        state.workers[t].id = t;
+        state.workers[t].buckets = calloc(state.ring, sizeof(struct vertex_array));
+        state.workers[t].outboxes = calloc(threads, sizeof(struct gdelta_requests));
+        ready = state.workers[t].buckets != NULL && state.workers[t].outboxes != NULL;
+    }
+
+    if (ready) {
+        for (size_t i = 0; i < vertex_len; i++) {
+            state.in_bucket[i] = SIZE_MAX;
+        }
+
+        _gdelta_bucket_add(&state, &state.workers[start_vertex % threads], start_vertex, 0);
+        ready = pthread_barrier_init(&state.barrier, NULL, threads) == 0;
+    }
+
+    if (ready) {
+        struct gdelta_task* tasks = malloc(sizeof(struct gdelta_task) * threads);
+        pthread_t* handles = malloc(sizeof(pthread_t) * threads);
+
+        // the calling thread is the first one, so the others
+        // are just created if they're needed
+        size_t created = 1;
+
+        if (tasks != NULL && handles != NULL) {
+            for (size_t t = 0; t < threads; t++) {
+                tasks[t] = (struct gdelta_task) {&state, &state.workers[t]};
+            }
+
+            for (; created < threads; created++) {
+                if (pthread_create(&handles[created], NULL, _gdelta_run, &tasks[created]) != 0) {
+                    break;
+                }
+            }
+        }
+
+        // the barrier waits for all the threads, so it can't
+        // run without any of them
+        ready = tasks != NULL && handles != NULL && created == threads;
+
+        pthread_mutex_lock(&state.gate);
+        state.gate_state = ready ? 1 : -1;
+        pthread_cond_broadcast(&state.gate_cond);
+        pthread_mutex_unlock(&state.gate);
+
+        if (ready) {
+            _gdelta_run(&tasks[0]);
+        }
+
+        for (size_t t = 1; t < created; t++) {
+            pthread_join(handles[t], NULL);
+        }
+
+        free(tasks);
+        free(handles);
+        pthread_barrier_destroy(&state.barrier);
+    }
+
+    for (size_t t = 0; state.workers != NULL && t < threads; t++) {
+        struct gdelta_worker* worker = &state.workers[t];
+        ready = ready && !worker->failed;
+
+        for (size_t b = 0; worker->buckets != NULL && b < state.ring; b++) {
+            vertex_array_destroy(&worker->buckets[b]);
+        }
+        for (size_t s = 0; worker->outboxes != NULL && s < threads; s++) {
+            free(worker->outboxes[s].data);
+        }
+
+        free(worker->buckets);
+        free(worker->outboxes);
+        vertex_array_destroy(&worker->frontier);
+        vertex_array_destroy(&worker->settled);
+    }
+
+    // the vertices behind the bucket of the destination vertex
+    // weren't settled, and the ones in its bucket are kept up to
+    // its distance, so the kept ones don't depend on delta
+    if (ready && end_vertex < vertex_len && out_tree->distances[end_vertex] != DISTANCE_MAX) {
+        distance_t last = out_tree->distances[end_vertex];
+
+        for (size_t i = 0; i < vertex_len; i++) {
+            if (out_tree->distances[i] != DISTANCE_MAX && out_tree->distances[i] > last) {
+                out_tree->distances[i] = DISTANCE_MAX;
+                out_tree->parents[i] = VERTEX_T_MAX;
+            }
+        }
+    }
+
+    free(state.strict);
+    free(state.in_bucket);
+    free(state.taken);
+    free(state.workers);
+
+    if (!ready) {
+        sssp_tree_destroy(out_tree);
+        return;
+    }
+
+    graph_sssp_ties(graph, out_tree);
+}
+
+static void* _gdelta_run(void* arg) {
+    struct gdelta_task* task = arg;
+    struct gdelta_state* state = task->state;
+    struct gdelta_worker* worker = task->worker;
+
+    pthread_mutex_lock(&state->gate);
+    while (state->gate_state == 0) {
+        pthread_cond_wait(&state->gate_cond, &state->gate);
+    }
+    bool aborted = state->gate_state < 0;
+    pthread_mutex_unlock(&state->gate);
+
+    if (aborted) {
+        return NULL;
+    }
+
+    size_t threads = state->threads;
+    size_t actual = 0;
+
+    for (;;) {
+        // relax the light edges until the bucket stays empty,
+        // they can add vertices into the same bucket again
+        for (;;) {
+            worker->frontier.len = 0;
+
+            struct vertex_array* bucket = &worker->buckets[actual % state->ring];
+
+            for (size_t k = 0; k < bucket->len; k++) {
+                vertex_t v = bucket->data[k];
+                // a vertex that moved to a lower bucket
+                // is still in the old one
+                if (state->in_bucket[v] != actual) {
+                    continue;
+                }
+
+                state->in_bucket[v] = SIZE_MAX;
+                _gdelta_append(worker, &worker->frontier, v);
+
+                if (!state->taken[v]) {
+                    state->taken[v] = true;
+                    _gdelta_append(worker, &worker->settled, v);
+                }
+            }
+
+            bucket->len = 0;
+
+            worker->active = worker->frontier.len > 0;
+            pthread_barrier_wait(&state->barrier);
+
+            bool active = false;
+            for (size_t t = 0; t < threads; t++) {
+                active = active || state->workers[t].active;
+            }
+
+            if (!active) {
+                break;
+            }
+
+            _gdelta_request(state, worker, &worker->frontier, true);
+            pthread_barrier_wait(&state->barrier);
+
+            _gdelta_relax(state, worker);
+            pthread_barrier_wait(&state->barrier);
+        }
+
+        // the distances of the bucket are final, so the heavy
+        // edges are relaxed just once
+        _gdelta_request(state, worker, &worker->settled, false);
+        pthread_barrier_wait(&state->barrier);
+
+        _gdelta_relax(state, worker);
+
+        for (size_t k = 0; k < worker->settled.len; k++) {
+            state->taken[worker->settled.data[k]] = false;
+        }
+        worker->settled.len = 0;
+
+        // the ring holds the buckets up to ring - 1 ahead
+        worker->next = SIZE_MAX;
+        for (size_t b = actual + 1; b < actual + state->ring; b++) {
+            if (worker->buckets[b % state->ring].len > 0) {
+                worker->next = b;
+                break;
+            }
+        }
+
+        pthread_barrier_wait(&state->barrier);
+
+        size_t next = SIZE_MAX;
+        for (size_t t = 0; t < threads; t++) {
+            next = state->workers[t].next < next ? state->workers[t].next : next;
+        }
+
+        // the destination vertex was settled with the bucket
+        vertex_t end_vertex = state->end_vertex;
+        bool done = end_vertex < state->tree->len && state->tree->distances[end_vertex] != DISTANCE_MAX
+                    && _gdelta_bucket(state, state->tree->distances[end_vertex]) <= actual;
+
+        // nobody writes next until everybody read it
+        pthread_barrier_wait(&state->barrier);
+
+        if (done || next == SIZE_MAX) {
+            break;
+        }
+
+        actual = next;
+    }
+
+    return NULL;
+}
+
+static void _gdelta_request(struct gdelta_state* state,
+                            struct gdelta_worker* worker,
+                            const struct vertex_array* vertices,
+                            bool light) {
+    size_t threads = state->threads;
+    const distance_t* distances = state->tree->distances;
+
+    for (size_t t = 0; t < threads; t++) {
+        worker->outboxes[t].len = 0;
+    }
+
+    for (size_t k = 0; k < vertices->len; k++) {
+        vertex_t i = vertices->data[k];
+
+        struct gneighbor_iterator it = {0};
+        graph_neighbors(state->graph, i, &it);
+
+        weight_t weight = 0;
+        for (vertex_t j = 0; gneighbor_next(&it, &j, &weight);) {
+            if ((weight <= state->delta) != light) {
+                continue;
+            }
+
+            struct gdelta_requests* outbox = &worker->outboxes[j % threads];
+
+            if (outbox->len >= outbox->capacity) {
+                size_t capacity = outbox->capacity > 0 ? outbox->capacity * 2 : 16;
+                struct gdelta_request* data = realloc(outbox->data, sizeof(struct gdelta_request) * capacity);
+                if (data == NULL) {
+                    worker->failed = true;
+                    continue;
+                }
+
+                outbox->capacity = capacity;
+                outbox->data = data;
+            }
+
+            distance_t distance = distances[i] + weight;
+            outbox->data[outbox->len++] = (struct gdelta_request) {j, i, distance, distances[i] < distance};
+        }
+    }
+}
+
+static void _gdelta_relax(struct gdelta_state* state, struct gdelta_worker* worker) {
+    distance_t* distances = state->tree->distances;
+    vertex_t* parents = state->tree->parents;
+
+    for (size_t t = 0; t < state->threads; t++) {
+        const struct gdelta_requests* inbox = &state->workers[t].outboxes[worker->id];
+
+        for (size_t k = 0; k < inbox->len; k++) {
+            const struct gdelta_request* request = &inbox->data[k];
+            vertex_t v = request->vertex;
+
+            if (request->distance < distances[v]) {
+                distances[v] = request->distance;
+                parents[v] = request->parent;
+                state->strict[v] = request->strict;
+
+                _gdelta_bucket_add(state, worker, v, _gdelta_bucket(state, request->distance));
+            } else if (request->distance == distances[v] && request->strict
+                       && (!state->strict[v] || request->parent < parents[v])) {
+                // the ties of zero weight edges are left to
+                // graph_sssp_ties
+                parents[v] = request->parent;
+                state->strict[v] = true;
+            }
+        }
+    }
+}
+
+static void _gdelta_bucket_add(struct gdelta_state* state, struct gdelta_worker* worker, vertex_t vertex, size_t bucket) {
+    if (state->in_bucket[vertex] == bucket) {
+        return;
+    }
+
+    state->in_bucket[vertex] = bucket;
+    _gdelta_append(worker, &worker->buckets[bucket % state->ring], vertex);
+}
+
+static void _gdelta_append(struct gdelta_worker* worker, struct vertex_array* array, vertex_t vertex) {
+    if (array->len >= array->capacity) {
+        vertex_array_reserve(array, array->capacity > 0 ? array->capacity : 16);
+
+        if (array->len >= array->capacity) {
+            worker->failed = true;
+            return;
+        }
+    }
+
+    array->data[array->len++] = vertex;
+}
@@ -3,7 +3,11 @@
 #include <string.h>
 
 #include <graph.h>
+#include <degree.h>
 #include <list.h>
+#include <row.h>
+#include <bitset.h>
+#include <heap.h>
 
 /**
  * Return the value that identifies that there is no an edge
@@ -12,7 +16,35 @@
  * @param graph the graph to get the value
  * @return the empty value
  */
-static inline int32_t g_empty_weight(const struct graph* graph);
+static inline weight_t g_empty_weight(const struct graph* graph);
+/**
+ * Return the row of a vertex in the adjacency matrix.
+ *
+ * @param graph the graph where the vertex belongs in
+ * @param vi the vertex
+ * @return the first cell of the row
+ */
+static inline weight_t* g_row(const struct graph* graph, vertex_t vi);
+/**
+ * Return the row of a vertex in the adjacency bitset.
+ *
+ * @param graph the graph where the vertex belongs in
+ * @param vi the vertex
+ * @return the first word of the row
+ */
+static inline uint64_t* g_bits(const struct graph* graph, vertex_t vi);
+/**
+ * Return the cell of an edge in the packed upper triangle.
+ *
+ * The cell <vi, wj> is the same as <wj, vi>, and it's stored
+ * in the column of the greatest vertex.
+ *
+ * @param graph the graph where the vertices belong in
+ * @param vi the source vertex
+ * @param wj the destination vertex
+ * @return the cell of the edge
+ */
+static inline weight_t* g_triangle(const struct graph* graph, vertex_t vi, vertex_t wj);
 /**
  * Check if two vertices belong in a graph.
  *
@@ -33,6 +65,214 @@ static inline bool g_is_out(const struct graph* graph, vertex_t vi, vertex_t wj)
  * @return true if it passes check, otherwise false
  */
 static bool g_initial_path(struct graph* graph, vertex_t start_vertex, vertex_t end_vertex);
+/**
+ * Find the weakest path between two different vertices by a
+ * search from both of them (bidirectional Dijkstra).
+ *
+ * Both searches take turns by the lower key, and they stop when
+ * the sum of both keys can't improve the weakest path where
+ * they met.
+ *
+ * @param graph the graph where the vertices belong in
+ * @param start_vertex the source vertex
+ * @param end_vertex the destination vertex
+ * @param out_path where it'll store the path
+ * @return true if it found the path, otherwise false
+ */
+static bool g_bidirectional_path(struct graph* graph,
+                                 vertex_t start_vertex,
+                                 vertex_t end_vertex,
+                                 struct path* out_path);
+/**
+ * Find the weakest path between two different vertices by a
+ * search directed to the destination vertex (A*), the
+ * landmarks give a lower bound of the remaining distance.
+ *
+ * The bounds are consistent, so a settled vertex is final and
+ * it stops when the destination vertex is settled.
+ *
+ * @param graph the graph where the vertices belong in
+ * @param landmarks the landmarks of the graph
+ * @param start_vertex the source vertex
+ * @param end_vertex the destination vertex
+ * @param out_path where it'll store the path
+ * @return true if it found the path, otherwise false
+ */
+static bool g_alt_path(struct graph* graph,
+                       const struct glandmarks* landmarks,
+                       vertex_t start_vertex,
+                       vertex_t end_vertex,
+                       struct path* out_path);
+/**
+ * Return the lower bound of the distance between two vertices
+ * given by the landmarks.
+ *
+ * @param landmarks the landmarks of the graph
+ * @param vi a vertex
+ * @param wj another vertex
+ * @return the lower bound, 0 if no landmark reaches both
+ */
+static distance_t g_alt_bound(const struct glandmarks* landmarks, vertex_t vi, vertex_t wj);
+/**
+ * Add the paths of a tree into a map, but the path of the
+ * source vertex.
+ *
+ * @param tree the tree of paths
+ * @param out_map where it'll store the paths, it's not
+ *                initialized if the tree is empty
+ */
+static void g_tree_paths(const struct sssp_tree* tree, u32path_map* out_map);
+/**
+ * Allocate a block aligned to ROW_ALIGNMENT.
+ *
+ * @param size the size in bytes of the block
+ * @return the allocated block, NULL if it couldn't
+ */
+static void* g_aligned_alloc(size_t size);
+/**
+ * Start the iteration of a dense layout, where the position
+ * is the column of the neighbor.
+ *
+ * @param it the iterator to start
+ */
+static void g_dense_neighbor_init(struct gneighbor_iterator* it);
+
+/*
+ * The operations of GRAPH_STORAGE_MATRIX, the rows are padded
+ * with the empty weight so they're scanned by the row kernels
+ * without a scalar tail.
+ */
+static bool g_matrix_reserve(struct graph* graph, size_t capacity);
+static void g_matrix_destroy(struct graph* graph);
+static bool g_matrix_has(const struct graph* graph, vertex_t vi, vertex_t wj);
+static weight_t g_matrix_get(const struct graph* graph, vertex_t vi, vertex_t wj);
+static void g_matrix_set(struct graph* graph, vertex_t vi, vertex_t wj, weight_t weight);
+static void g_matrix_del(struct graph* graph, vertex_t vi, vertex_t wj);
+static size_t g_matrix_degree(const struct graph* graph, vertex_t vi);
+static bool g_matrix_neighbor_next(struct gneighbor_iterator* it, vertex_t* out_vertex, weight_t* out_weight);
+
+/*
+ * The operations of GRAPH_STORAGE_CSR, the neighbors are the
+ * run of the vertex and the position is an index in it.
+ */
+static bool g_csr_reserve(struct graph* graph, size_t capacity);
+static void g_csr_destroy(struct graph* graph);
+static void g_csr_build(struct graph* graph, size_t len, const struct edge* edges, size_t edge_len);
+static bool g_csr_has(const struct graph* graph, vertex_t vi, vertex_t wj);
+static weight_t g_csr_get(const struct graph* graph, vertex_t vi, vertex_t wj);
+static void g_csr_set(struct graph* graph, vertex_t vi, vertex_t wj, weight_t weight);
+static void g_csr_del(struct graph* graph, vertex_t vi, vertex_t wj);
+static size_t g_csr_degree(const struct graph* graph, vertex_t vi);
+static void g_csr_neighbor_init(struct gneighbor_iterator* it);
+static bool g_csr_neighbor_next(struct gneighbor_iterator* it, vertex_t* out_vertex, weight_t* out_weight);
+
+/*
+ * The operations of GRAPH_STORAGE_BITSET, the masked neighbors
+ * are discarded a whole word at once.
+ */
+static bool g_bitset_reserve(struct graph* graph, size_t capacity);
+static void g_bitset_destroy(struct graph* graph);
+static bool g_bitset_has(const struct graph* graph, vertex_t vi, vertex_t wj);
+static weight_t g_bitset_get(const struct graph* graph, vertex_t vi, vertex_t wj);
+static void g_bitset_set(struct graph* graph, vertex_t vi, vertex_t wj, weight_t weight);
+static void g_bitset_del(struct graph* graph, vertex_t vi, vertex_t wj);
+static size_t g_bitset_degree(const struct graph* graph, vertex_t vi);
+static bool g_bitset_neighbor_next(struct gneighbor_iterator* it, vertex_t* out_vertex, weight_t* out_weight);
+
+/*
+ * The operations of GRAPH_STORAGE_TRIANGLE, the upper part of
+ * a column is contiguous and it's scanned by the row kernels,
+ * the lower part is walked stepping from a column to the next
+ * one without computing the index again.
+ */
+static bool g_triangle_reserve(struct graph* graph, size_t capacity);
+static void g_triangle_destroy(struct graph* graph);
+static bool g_triangle_has(const struct graph* graph, vertex_t vi, vertex_t wj);
+static weight_t g_triangle_get(const struct graph* graph, vertex_t vi, vertex_t wj);
+static void g_triangle_set(struct graph* graph, vertex_t vi, vertex_t wj, weight_t weight);
+static void g_triangle_del(struct graph* graph, vertex_t vi, vertex_t wj);
+static size_t g_triangle_degree(const struct graph* graph, vertex_t vi);
+static bool g_triangle_neighbor_next(struct gneighbor_iterator* it, vertex_t* out_vertex, weight_t* out_weight);
+
+/*
+ * The operations of GRAPH_STORAGE_INDEXED, the edges are
+ * looked up in the matrix and the neighbors are iterated from
+ * the lists, where the position is an index.
+ */
+static bool g_indexed_reserve(struct graph* graph, size_t capacity);
+static void g_indexed_destroy(struct graph* graph);
+static void g_indexed_set(struct graph* graph, vertex_t vi, vertex_t wj, weight_t weight);
+static void g_indexed_del(struct graph* graph, vertex_t vi, vertex_t wj);
+static size_t g_indexed_degree(const struct graph* graph, vertex_t vi);
+static void g_indexed_neighbor_init(struct gneighbor_iterator* it);
+static bool g_indexed_neighbor_next(struct gneighbor_iterator* it, vertex_t* out_vertex, weight_t* out_weight);
+/**
+ * Add a vertex at the end of the neighbor list of another one.
+ *
+ * @param graph the graph where the vertices belong in
+ * @param vi the vertex whose list is appended
+ * @param wj the neighbor to add
+ */
+static void g_indexed_push(struct graph* graph, vertex_t vi, vertex_t wj);
+/**
+ * Remove a vertex from the neighbor list of another one in
+ * O(1), the last neighbor is moved into its position.
+ *
+ * @param graph the graph where the vertices belong in
+ * @param vi the vertex whose list is modified
+ * @param wj the neighbor to remove
+ */
+static void g_indexed_swap_remove(struct graph* graph, vertex_t vi, vertex_t wj);
+/**
+ * Clear an edge from the storage of a graph and update the
+ * degrees, the edge must exist.
+ *
+ * It doesn't check the vertices nor the cache.
+ *
+ * @param graph the graph where to clear the edge
+ * @param vi the source vertex
+ * @param wj the destination vertex
+ */
+static void g_unlink(struct graph* graph, vertex_t vi, vertex_t wj);
+/**
+ * Initialize the degrees of a graph from the edges that its
+ * storage has, it's used when the storage was built at once.
+ *
+ * @param graph the graph to initialize its degrees
+ */
+static void g_init_degrees(struct graph* graph);
+/**
+ * Update the cached connected components with a new vertex
+ * that doesn't have edges.
+ *
+ * @param graph the graph where the vertex was added in
+ * @param vi the added vertex
+ */
+static void g_cache_add_vertex(struct graph* graph, vertex_t vi);
+/**
+ * Update the cached connected components after removing a
+ * vertex, it's computed again just the connected component
+ * where the vertex belonged in.
+ *
+ * @param graph the graph where the vertex was removed from
+ * @param vi the removed vertex, it must not have edges anymore
+ */
+static void g_cache_remove_vertex(struct graph* graph, vertex_t vi);
+/**
+ * Renumber the vertices of cached connected components.
+ *
+ * @param comp the connected components to renumber
+ * @param map the new vertex of each old vertex
+ * @param len the length of vertices after renumbering
+ */
+static void g_cache_remap(struct gcomponent* comp, const vertex_t* map, size_t len);
+/**
+ * Destroy the cached landmarks of a graph, they're not valid
+ * anymore when a vertex is added or removed.
+ *
+ * @param graph the graph to destroy its landmarks
+ */
+static void g_invalidate_landmarks(struct graph* graph);
 /**
  * Destroy a cache of a graph.
  *
@@ -40,27 +280,184 @@ static bool g_initial_path(struct graph* graph, vertex_t start_vertex, vertex_t
  */
 static void g_invalidate_cache(struct graph* graph);
 
+static const struct graph_ops g_matrix_ops = {
+    .storage = GRAPH_STORAGE_MATRIX,
+    .reserve = g_matrix_reserve,
+    .destroy = g_matrix_destroy,
+    .build = NULL,
+    .has = g_matrix_has,
+    .get = g_matrix_get,
+    .set = g_matrix_set,
+    .del = g_matrix_del,
+    .degree = g_matrix_degree,
+    .neighbor_init = g_dense_neighbor_init,
+    .neighbor_next = g_matrix_neighbor_next,
+};
+
+static const struct graph_ops g_csr_ops = {
+    .storage = GRAPH_STORAGE_CSR,
+    .reserve = g_csr_reserve,
+    .destroy = g_csr_destroy,
+    .build = g_csr_build,
+    .has = g_csr_has,
+    .get = g_csr_get,
+    .set = g_csr_set,
+    .del = g_csr_del,
+    .degree = g_csr_degree,
+    .neighbor_init = g_csr_neighbor_init,
+    .neighbor_next = g_csr_neighbor_next,
+};
+
+static const struct graph_ops g_bitset_ops = {
+    .storage = GRAPH_STORAGE_BITSET,
+    .reserve = g_bitset_reserve,
+    .destroy = g_bitset_destroy,
+    .build = NULL,
+    .has = g_bitset_has,
+    .get = g_bitset_get,
+    .set = g_bitset_set,
+    .del = g_bitset_del,
+    .degree = g_bitset_degree,
+    .neighbor_init = g_dense_neighbor_init,
+    .neighbor_next = g_bitset_neighbor_next,
+};
+
+static const struct graph_ops g_triangle_ops = {
+    .storage = GRAPH_STORAGE_TRIANGLE,
+    .reserve = g_triangle_reserve,
+    .destroy = g_triangle_destroy,
+    .build = NULL,
+    .has = g_triangle_has,
+    .get = g_triangle_get,
+    .set = g_triangle_set,
+    .del = g_triangle_del,
+    .degree = g_triangle_degree,
+    .neighbor_init = g_dense_neighbor_init,
+    .neighbor_next = g_triangle_neighbor_next,
+};
+
+static const struct graph_ops g_indexed_ops = {
+    .storage = GRAPH_STORAGE_INDEXED,
+    .reserve = g_indexed_reserve,
+    .destroy = g_indexed_destroy,
+    .build = NULL,
+    .has = g_matrix_has,
+    .get = g_matrix_get,
+    .set = g_indexed_set,
+    .del = g_indexed_del,
+    .degree = g_indexed_degree,
+    .neighbor_init = g_indexed_neighbor_init,
+    .neighbor_next = g_indexed_neighbor_next,
+};
+
 void graph_init(struct graph* graph, bool weighted, size_t len) {
-    if (graph == NULL) {
+    graph_init_ops(graph, weighted, len, &g_matrix_ops, NULL, 0);
+}
+
+void graph_init_edges(struct graph* graph,
+                      bool weighted,
+                      size_t len,
+                      enum graph_storage storage,
+                      const struct edge* edges,
+                      size_t edge_len) {
+    if (edges == NULL) {
+        edge_len = 0;
+    }
+
+    if (storage == GRAPH_STORAGE_AUTO) {
+        storage = graph_pick_storage(weighted, len, edge_len);
+    }
+
+    // a bitset just can tell if there is an edge
+    if (storage == GRAPH_STORAGE_BITSET && weighted) {
+        storage = GRAPH_STORAGE_MATRIX;
+    }
+
+    const struct graph_ops* ops = graph_storage_ops(storage);
+    if (ops == NULL) {
+        ops = &g_matrix_ops;
+    }
+
+    graph_init_ops(graph, weighted, len, ops, edges, edge_len);
+}
+
+void graph_init_ops(struct graph* graph,
+                    bool weighted,
+                    size_t len,
+                    const struct graph_ops* ops,
+                    const struct edge* edges,
+                    size_t edge_len) {
+    if (graph == NULL || ops == NULL) {
         return;
     }
 
+    if (edges == NULL) {
+        edge_len = 0;
+    }
+
     graph_destroy(graph);
 
     graph->weighted = weighted;
+    graph->ops = ops;
+
+    for (size_t k = 0; k < edge_len; k++) {
+        weight_t weight = edges[k].weight;
+
+        if (weight != g_empty_weight(graph)) {
+            weight = weighted ? weight : 1;
+            graph->max_weight = weight > graph->max_weight ? weight : graph->max_weight;
+        }
+    }
+
+    // the layout can be built at once instead of inserting
+    // every edge
+    if (ops->build != NULL) {
+        ops->build(graph, len, edges, edge_len);
+        g_init_degrees(graph);
+        return;
+    }
 
-    int32_t initial_value = g_empty_weight(graph);
+    if (!ops->reserve(graph, len)) {
+        return;
+    }
 
     graph->len = len;
-    graph->matrix = malloc(sizeof(int32_t*) * len);
+    gdegree_init(&graph->degree, len, NULL);
 
-    // initialize the adjacency matrix with the default
-    // value of graph
-    for (vertex_t i = 0; i < len; i++) {
-        graph->matrix[i] = malloc(sizeof(int32_t) * len);
-        for (vertex_t j = 0; j < len; j++) {
-            graph->matrix[i][j] = initial_value;
-        }
+    for (size_t k = 0; k < edge_len; k++) {
+        graph_addw(graph, edges[k].vi, edges[k].wj, edges[k].weight);
+    }
+}
+
+enum graph_storage graph_pick_storage(bool weighted, size_t len, size_t edge_len) {
+    if (len == 0) {
+        return GRAPH_STORAGE_CSR;
+    }
+
+    // every edge takes two cells, <vi, wj> and <wj, vi>
+    double density = 2.0 * edge_len / ((double) len * len);
+
+    if (weighted) {
+        return density >= GRAPH_AUTO_MATRIX_DENSITY ? GRAPH_STORAGE_MATRIX : GRAPH_STORAGE_CSR;
+    }
+
+    return density >= GRAPH_AUTO_BITSET_DENSITY ? GRAPH_STORAGE_BITSET : GRAPH_STORAGE_CSR;
+}
+
+const struct graph_ops* graph_storage_ops(enum graph_storage storage) {
+    switch (storage) {
+        case GRAPH_STORAGE_MATRIX:
+            return &g_matrix_ops;
+        case GRAPH_STORAGE_CSR:
+            return &g_csr_ops;
+        case GRAPH_STORAGE_BITSET:
+            return &g_bitset_ops;
+        case GRAPH_STORAGE_TRIANGLE:
+            return &g_triangle_ops;
+        case GRAPH_STORAGE_INDEXED:
+            return &g_indexed_ops;
+        default:
+            return NULL;
     }
 }
 
@@ -69,17 +466,17 @@ void graph_print(const struct graph* graph) {
         return;
     }
 
-    int32_t empty_weight = g_empty_weight(graph);
+    weight_t empty_weight = g_empty_weight(graph);
 
     for (vertex_t i = 0; i < graph->len; i++) {
         printf("(");
         for (vertex_t j = 0; j < graph->len; j++) {
-            int32_t weight = graph->matrix[i][j];
+            weight_t weight = graph_get(graph, i, j);
 
             if (graph->weighted && weight == empty_weight) {
                 printf("  -");
             } else {
-                printf("%3d", weight);
+                printf("%3" WEIGHT_PRI, weight);
             }
 
             if (j + 1 != graph->len) {
@@ -99,30 +496,211 @@ void graph_destroy(struct graph* graph) {
 
     g_invalidate_cache(graph);
 
-    if (graph->matrix != NULL) {
-        for (vertex_t i = 0; i < graph->len; i++) {
-            free(graph->matrix[i]);
-        }
-        free(graph->matrix);
+    if (graph->ops != NULL) {
+        graph->ops->destroy(graph);
     }
 
+    free(graph->removed);
+    gdegree_destroy(&graph->degree);
+
+    graph->ops = NULL;
+    graph->impl = NULL;
+    graph->edge_len = 0;
+    graph->max_weight = 0;
     graph->len = 0;
-    graph->matrix = NULL;
+    graph->capacity = 0;
+    graph->removed = NULL;
+}
+
+vertex_t graph_add_vertex(struct graph* graph) {
+    if (graph == NULL) {
+        return VERTEX_T_MAX;
+    }
+
+    // a graph that was not initialized is a matrix
+    if (graph->ops == NULL) {
+        graph->ops = &g_matrix_ops;
+    }
+
+    // grow geometrically to add vertices in amortized time
+    if (graph->len >= graph->capacity) {
+        size_t capacity = graph->capacity > 0 ? graph->capacity * 2 : 16;
+        if (!graph->ops->reserve(graph, capacity)) {
+            return VERTEX_T_MAX;
+        }
+
+        graph->capacity = capacity;
+    }
+
+    if (graph->removed != NULL) {
+        size_t words = bitset_words(graph->capacity);
+        uint64_t* removed = realloc(graph->removed, sizeof(uint64_t) * words);
+        if (removed == NULL) {
+            return VERTEX_T_MAX;
+        }
+
+        size_t used_words = bitset_words(graph->len + 1);
+        for (size_t w = bitset_words(graph->len); w < used_words; w++) {
+            removed[w] = 0;
+        }
+
+        graph->removed = removed;
+        bitset_clear(graph->removed, graph->len);
+    }
+
+    // the reserved rows and columns are already empty
+    vertex_t vi = graph->len++;
+    gdegree_add_vertex(&graph->degree);
+    g_cache_add_vertex(graph, vi);
+    g_invalidate_landmarks(graph);
+
+    return vi;
 }
 
-void graph_addw(struct graph* graph, vertex_t vi, vertex_t wj, int32_t weight) {
-    if (g_is_out(graph, vi, wj) || graph->matrix[vi][wj] == weight) {
+void graph_remove_vertex(struct graph* graph, vertex_t vi) {
+    if (g_is_out(graph, vi, vi)) {
+        return;
+    }
+
+    if (graph->removed == NULL) {
+        graph->removed = calloc(bitset_words(graph->capacity), sizeof(uint64_t));
+        if (graph->removed == NULL) {
+            return;
+        }
+    }
+
+    // the neighbors are collected before undoing the edges
+    // to not modify the storage while it's iterated
+    struct vertex_array neighbors = {0};
+    vertex_array_reserve(&neighbors, graph_rcount(graph, vi));
+
+    struct gneighbor_iterator it = {0};
+    graph_neighbors(graph, vi, &it);
+
+    for (vertex_t j = 0; gneighbor_next(&it, &j, NULL);) {
+        vertex_array_reserve(&neighbors, 1);
+        neighbors.data[neighbors.len++] = j;
+    }
+
+    for (size_t k = 0; k < neighbors.len; k++) {
+        g_unlink(graph, vi, neighbors.data[k]);
+    }
+
+    vertex_array_destroy(&neighbors);
+
+    bitset_set(graph->removed, vi);
+    g_cache_remove_vertex(graph, vi);
+    g_invalidate_landmarks(graph);
+}
+
+void graph_compact(struct graph* graph, vertex_t* out_map) {
+    if (graph == NULL) {
+        return;
+    }
+
+    size_t old_len = graph->len;
+
+    vertex_t* map = out_map != NULL ? out_map : malloc(sizeof(vertex_t) * (old_len + 1));
+    size_t len = 0;
+
+    for (vertex_t i = 0; i < old_len; i++) {
+        bool removed = graph->removed != NULL && bitset_get(graph->removed, i);
+        map[i] = removed ? VERTEX_T_MAX : len++;
+    }
+
+    if (len == old_len) {
+        if (out_map == NULL) {
+            free(map);
+        }
+
+        return;
+    }
+
+    // collect every edge just once, <i, j> with i <= j, with
+    // the new vertices
+    struct edge* edges = NULL;
+    size_t edge_len = 0;
+    size_t edge_cap = 0;
+
+    for (vertex_t i = 0; i < old_len; i++) {
+        if (map[i] == VERTEX_T_MAX) {
+            continue;
+        }
+
+        struct gneighbor_iterator it = {0};
+        graph_neighbors(graph, i, &it);
+
+        weight_t weight = 0;
+        for (vertex_t j = 0; gneighbor_next(&it, &j, &weight);) {
+            if (j < i) {
+                continue;
+            }
+
+            if (edge_len >= edge_cap) {
+                edge_cap = edge_cap > 0 ? edge_cap * 2 : 16;
+                edges = realloc(edges, sizeof(struct edge) * edge_cap);
+            }
+
+            edges[edge_len++] = (struct edge) {map[i], map[j], weight};
+        }
+    }
+
+    // the connected components don't change, so they're kept
+    // with the new vertices
+    struct gcomponent* component = graph->cache.component;
+    graph->cache.component = NULL;
+
+    graph_init_ops(graph, graph->weighted, len, graph->ops, edges, edge_len);
+
+    if (component != NULL) {
+        g_cache_remap(component, map, len);
+        graph->cache.component = component;
+    }
+
+    free(edges);
+    if (out_map == NULL) {
+        free(map);
+    }
+}
+
+void graph_addw(struct graph* graph, vertex_t vi, vertex_t wj, weight_t weight) {
+    if (g_is_out(graph, vi, wj) || graph_get(graph, vi, wj) == weight) {
         return;
     }
-    
-    g_invalidate_cache(graph);
 
     if (!graph->weighted && weight != 0) {
         weight = 1;
     }
 
-    graph->matrix[vi][wj] = weight;
-    graph->matrix[wj][vi] = weight;
+    // an empty weight is the same as undoing the edge
+    if (weight == g_empty_weight(graph)) {
+        graph_del(graph, vi, wj);
+        return;
+    }
+    
+    bool linked = graph->ops->has(graph, vi, wj);
+
+    g_invalidate_cache(graph);
+    graph->ops->set(graph, vi, wj, weight);
+
+    // a layout can fail to insert the edge, then nothing changes
+    if (!linked && !graph->ops->has(graph, vi, wj)) {
+        return;
+    }
+
+    if (weight > graph->max_weight) {
+        graph->max_weight = weight;
+    }
+
+    // a new edge adds a neighbor in both vertices, but a loop
+    // just in one
+    if (!linked) {
+        graph->edge_len++;
+        gdegree_inc(&graph->degree, vi);
+        if (vi != wj) {
+            gdegree_inc(&graph->degree, wj);
+        }
+    }
 }
 
 void graph_add(struct graph* graph, vertex_t vi, vertex_t wj) {
@@ -134,18 +712,15 @@ bool graph_has(const struct graph* graph, vertex_t vi, vertex_t wj) {
         return false;
     }
 
-    int32_t weight = graph->matrix[vi][wj];
-    int32_t empty_weight = g_empty_weight(graph);
-
-    return weight != empty_weight;
+    return graph->ops->has(graph, vi, wj);
 }
 
-int32_t graph_get(const struct graph* graph, vertex_t vi, vertex_t wj) {
+weight_t graph_get(const struct graph* graph, vertex_t vi, vertex_t wj) {
     if (g_is_out(graph, vi, wj)) {
         return g_empty_weight(graph);
     }
 
-    return graph->matrix[vi][wj];
+    return graph->ops->get(graph, vi, wj);
 }
 
 void graph_del(struct graph* graph, vertex_t vi, vertex_t wj) {
@@ -153,11 +728,12 @@ void graph_del(struct graph* graph, vertex_t vi, vertex_t wj) {
         return;
     }
 
-    g_invalidate_cache(graph);
+    if (!graph->ops->has(graph, vi, wj)) {
+        return;
+    }
 
-    int32_t empty_weight = g_empty_weight(graph);
-    graph->matrix[vi][wj] = empty_weight;
-    graph->matrix[wj][vi] = empty_weight;
+    g_invalidate_cache(graph);
+    g_unlink(graph, vi, wj);
 }
 
 size_t graph_rcount(const struct graph* graph, vertex_t vi) {
@@ -165,16 +741,7 @@ size_t graph_rcount(const struct graph* graph, vertex_t vi) {
         return 0;
     }
 
-    size_t count = 0;
-    int32_t empty_weight = g_empty_weight(graph);
-
-    for (vertex_t j = 0; j < graph->len; j++) {
-        if (graph->matrix[vi][j] != empty_weight) {
-            count++;
-        }
-    }
-
-    return count;
+    return graph->degree.degrees[vi];
 }
 
 size_t graph_ccount(const struct graph* graph, vertex_t wj) {
@@ -182,16 +749,61 @@ size_t graph_ccount(const struct graph* graph, vertex_t wj) {
         return 0;
     }
 
-    size_t count = 0;
-    int32_t empty_weight = g_empty_weight(graph);
+    // the graph is undirected, so the column is the same as
+    // the row of wj
+    return graph->degree.degrees[wj];
+}
+
+size_t graph_edge_count(const struct graph* graph) {
+    return graph != NULL ? graph->edge_len : 0;
+}
 
-    for (vertex_t i = 0; i < graph->len; i++) {
-        if (graph->matrix[i][wj] != empty_weight) {
-            count++;
-        }
+size_t graph_min_degree(const struct graph* graph) {
+    return graph != NULL ? gdegree_min(&graph->degree) : 0;
+}
+
+size_t graph_max_degree(const struct graph* graph) {
+    return graph != NULL ? gdegree_max(&graph->degree) : 0;
+}
+
+const vertex_t* graph_degree_vertices(const struct graph* graph, size_t degree, size_t* out_len) {
+    if (out_len == NULL) {
+        return NULL;
+    }
+    if (graph == NULL) {
+        *out_len = 0;
+        return NULL;
     }
 
-    return count;
+    return gdegree_bucket(&graph->degree, degree, out_len);
+}
+
+void graph_neighbors(const struct graph* graph, vertex_t vi, struct gneighbor_iterator* out_it) {
+    if (out_it == NULL) {
+        return;
+    }
+
+    out_it->graph = graph;
+    out_it->vertex = vi;
+    out_it->mask = NULL;
+    out_it->pos = 0;
+    out_it->end = 0;
+
+    // an iterator without graph doesn't give neighbors
+    if (g_is_out(graph, vi, vi)) {
+        out_it->graph = NULL;
+        return;
+    }
+
+    graph->ops->neighbor_init(out_it);
+}
+
+bool gneighbor_next(struct gneighbor_iterator* it, vertex_t* out_vertex, weight_t* out_weight) {
+    if (it == NULL || it->graph == NULL) {
+        return false;
+    }
+
+    return it->graph->ops->neighbor_next(it, out_vertex, out_weight);
 }
 
 void graph_wave(const struct graph* graph,
@@ -204,20 +816,24 @@ void graph_wave(const struct graph* graph,
     }
 
     // initialize the wave with the source vertex
-    wave_init(out_wave, NULL, start_vertex);
+    wave_init(out_wave, start_vertex);
 
     size_t vertex_len = graph->len;
 
-    bool* visited = calloc(vertex_len, sizeof(bool));
+    // visited is a bitset, such that the neighbors that were
+    // already visited can be discarded a whole word at once
+    uint64_t* visited = calloc(bitset_words(vertex_len), sizeof(uint64_t));
     // inter_visited is used to be able duplicate the
     // vertices if there are several inter-connected between
     // themselves
     bool* inter_visited = calloc(vertex_len, sizeof(bool));
+    // the vertices that are marked in inter_visited
+    struct vertex_array inter_vertices = {0};
 
-    // allow to track which wave belongs a vertex in a fast way
-    vtwave_map wave_track = {0};
-    hashmap_init(&wave_track, 0, NULL);
-    hashmap_put(&wave_track, start_vertex, out_wave);
+    // allow to track which node of the wave belongs a vertex
+    // in a fast way, just the queued vertices are set
+    size_t* wave_track = malloc(sizeof(size_t) * vertex_len);
+    wave_track[start_vertex] = 0;
 
     struct queue_vertex wave_queue = {0};
     queue_vertex_init(&wave_queue);
@@ -237,21 +853,29 @@ void graph_wave(const struct graph* graph,
             repeat_size--;
 
             vertex_t i = queue_vertex_del(&wave_queue);
-            visited[i] = true;
-
-            struct wave* wave = hashmap_get(&wave_track, i);
-
-            for (vertex_t j = 0; j < vertex_len; j++) {
-                if (visited[j] || !graph_has(graph, i, j)) {
-                    continue;
+            bitset_set(visited, i);
+
+            size_t node = wave_track[i];
+
+            struct gneighbor_iterator it = {0};
+            graph_neighbors(graph, i, &it);
+            // skip the vertices that were already seen, the bitset
+            // storage discards them a whole word at once
+            it.mask = visited;
+
+            for (vertex_t j = 0; gneighbor_next(&it, &j, NULL);) {
+                // remember it just once to merge it later in
+                // visited
+                if (!inter_visited[j]) {
+                    inter_visited[j] = true;
+                    vertex_array_reserve(&inter_vertices, 1);
+                    inter_vertices.data[inter_vertices.len++] = j;
                 }
 
-                inter_visited[j] = true;
-
-                // add the vertex j as sub-wave of vertex i,
-                // in same way, it'll be added the generated
-                // sub-wave in the map.
-                hashmap_put(&wave_track, j, wave_add(wave, j));
+                // add the vertex j as sub-node of vertex i,
+                // in same way, it'll be tracked the generated
+                // sub-node.
+                wave_track[j] = wave_add(out_wave, node, j);
 
                 found_vertex |= j == end_vertex;
 
@@ -265,16 +889,21 @@ void graph_wave(const struct graph* graph,
             }
         };
 
-        for (size_t i = 0; i < vertex_len; i++) {
-            visited[i] |= inter_visited[i];
-            inter_visited[i] = false;
+        // just the vertices reached along this step are merged,
+        // instead of sweeping over all of them
+        for (size_t k = 0; k < inter_vertices.len; k++) {
+            vertex_t j = inter_vertices.data[k];
+            bitset_set(visited, j);
+            inter_visited[j] = false;
         }
+        inter_vertices.len = 0;
     }
     
     free(visited); 
     free(inter_visited);
+    vertex_array_destroy(&inter_vertices);
 
-    hashmap_destroy(&wave_track);
+    free(wave_track);
     queue_vertex_destroy(&wave_queue);
 }
 
@@ -297,70 +926,67 @@ void graph_components(struct graph* graph, const struct gcomponent** out_comp) {
     // size of vertices that there are in the graph
     size_t vertex_len = graph->len;
 
-    // indicates how many left vertices there are
-    size_t remaining_len = vertex_len;
     // indicates which connected component belongs a vertex
     // this is structured as the following way:
     //     vertex_classes[vertex] = connected component ID
     // the connected component ID is invalid if it is 0
     uint32_t* vertex_classes = calloc(vertex_len, sizeof(uint32_t));
+    // the vertices that already have a connected component,
+    // it's used to skip them while looking for neighbors
+    uint64_t* classified = calloc(bitset_words(vertex_len), sizeof(uint64_t));
 
     // size of connected components exist
     // p by notation |G| = p
-    size_t p = vertex_len;
+    size_t p = 0;
+
+    // every vertex is queued just once, so an array is enough
+    // to be used as the queue of the traversal
+    vertex_t* queue = malloc(sizeof(vertex_t) * (vertex_len + 1));
 
-    for (vertex_t i = 0; i < vertex_len && remaining_len > 0; i++) {
+    for (vertex_t i = 0; i < vertex_len; i++) {
         // the vertex i already belongs in a connected component
         // or in other words, it already was visited
         if (vertex_classes[i] != 0) {
             continue;
         }
+        // the removed vertices don't belong in any connected
+        // component
+        if (graph->removed != NULL && bitset_get(graph->removed, i)) {
+            continue;
+        }
 
-        // class_id represents the connected component ID
+        // class_id represents the connected component ID, it
+        // is given by the lowest vertex that belongs in
         uint32_t class_id = i + 1;
         vertex_classes[i] = class_id;
+        bitset_set(classified, i);
+        p++;
 
-        for (vertex_t j = 0; j < vertex_len && remaining_len > 0; j++) {
-            // if there is no edge (i, j) then it'll be ignored
-            if (!graph_has(graph, i, j)) {
-                continue;
-            }
-            
-            // if it already belongs in the same connected
-            // component, then ignore it
-            if (vertex_classes[j] == class_id) {
-                continue;
-            }
-
-            // decrease size of connected components that exist
-            p--;
-
-            // if it doesn't still belong in a connected
-            // component then add it in one
-            if (vertex_classes[j] == 0) {
-                vertex_classes[j] = class_id;
-                remaining_len--;
-                continue;
-            }
+        size_t queue_head = 0;
+        size_t queue_tail = 0;
+        queue[queue_tail++] = i;
 
-            // if the vertex j belongs in another connected
-            // component then change all vertices that belong
-            // in the actual connected component in the
-            // connected component of vertex j
+        // spread the ID to all vertices that are reachable
+        // from i, following just the edges that exist
+        while (queue_head < queue_tail) {
+            vertex_t k = queue[queue_head++];
 
-            uint32_t old_class_id = class_id;
-            class_id = vertex_classes[j];
+            struct gneighbor_iterator it = {0};
+            graph_neighbors(graph, k, &it);
+            // the vertices with an ID are not spread again
+            it.mask = classified;
 
-            for (vertex_t k = 0; k < vertex_len; k++) {
-                if (vertex_classes[k] == old_class_id) {
-                    vertex_classes[k] = class_id;
-                }
+            for (vertex_t j = 0; gneighbor_next(&it, &j, NULL);) {
+                vertex_classes[j] = class_id;
+                bitset_set(classified, j);
+                queue[queue_tail++] = j;
             }
         }
-
-        remaining_len--;
     }
 
+    free(queue);
+    free(classified);
+
     // generate a cache version to avoid recomputing twice
     // the connected components that belong the vertices
 
@@ -377,6 +1003,9 @@ void graph_components(struct graph* graph, const struct gcomponent** out_comp) {
 
     for (size_t i = 0; i < vertex_len; i++) {
         uint32_t i_class = vertex_classes[i];
+        if (i_class == 0) {
+            continue;
+        }
 
         struct vertex_array* arr = hashmap_get(map, i_class);
 
@@ -415,191 +1044,1548 @@ bool graph_reachable(struct graph* graph, vertex_t start_vertex, vertex_t end_ve
     return data[start_vertex] == data[end_vertex];
 }
 
-void graph_short_path(struct graph* graph,
-                      vertex_t start_vertex,
-                      vertex_t end_vertex,
-                      u32vertices_map* out_map) {
-    if (out_map == NULL || !g_initial_path(graph, start_vertex, end_vertex)) {
+void graph_bfs_dag(const struct graph* graph,
+                   vertex_t start_vertex,
+                   vertex_t end_vertex,
+                   struct bfs_dag* out_dag) {
+    if (out_dag == NULL) {
         return;
     }
 
-    // generate the waves
-    struct wave root_wave = {0};
-    graph_wave(graph, start_vertex, end_vertex, true, &root_wave);
-
-    // transform the waves into paths
-    u32path_map paths = {0};
-    wave_to_path(&root_wave, &paths);
+    *out_dag = (struct bfs_dag) {0};
+    if (g_is_out(graph, start_vertex, start_vertex)) {
+        return;
+    }
 
-    hashmap_init(out_map, hashmap_size(&paths), u32vertices_destroyer);
-    mkey_t next_key = 0;
+    size_t vertex_len = graph->len;
+    if (!bfs_dag_init(out_dag, vertex_len, start_vertex)) {
+        return;
+    }
 
-    // now filter all paths where the final vertex matches
-    // with the destination vertex
+    vertex_t* hops = out_dag->hops;
+    size_t* offsets = out_dag->offsets;
 
-    struct hashmap_iterator path_it = {0};
-    hashmap_iterator_init(&path_it, &paths);
-    for (struct map_entry entry; hashmap_iterator_next(&path_it, &entry);) {
-        struct path* path = entry.value;
-        struct vertex_array* vertices = &path->vertices;
+    // the reached vertices in order, it's also the queue
+    vertex_t* queue = malloc(sizeof(vertex_t) * vertex_len);
+    if (queue == NULL) {
+        bfs_dag_destroy(out_dag);
+        return;
+    }
+
+    size_t queue_head = 0;
+    size_t queue_tail = 0;
+    queue[queue_tail++] = start_vertex;
+
+    while (queue_head < queue_tail) {
+        vertex_t i = queue[queue_head];
+
+        // the layer of the destination vertex was reached
+        // whole, the next ones can't be in its paths
+        if (end_vertex < vertex_len && hops[end_vertex] != VERTEX_T_MAX && hops[i] >= hops[end_vertex]) {
+            break;
+        }
+
+        queue_head++;
+
+        struct gneighbor_iterator it = {0};
+        graph_neighbors(graph, i, &it);
+
+        for (vertex_t j = 0; gneighbor_next(&it, &j, NULL);) {
+            if (hops[j] == VERTEX_T_MAX) {
+                hops[j] = hops[i] + 1;
+                queue[queue_tail++] = j;
+            }
+        }
+    }
+
+    // a parent is a neighbor one layer closer, the parents of
+    // every vertex are counted first to lay them out flat
+    for (size_t k = 1; k < queue_tail; k++) {
+        vertex_t j = queue[k];
+
+        struct gneighbor_iterator it = {0};
+        graph_neighbors(graph, j, &it);
+
+        for (vertex_t i = 0; gneighbor_next(&it, &i, NULL);) {
+            offsets[j + 1] += hops[i] != VERTEX_T_MAX && hops[i] + 1 == hops[j];
+        }
+    }
+
+    for (size_t v = 0; v < vertex_len; v++) {
+        offsets[v + 1] += offsets[v];
+    }
+
+    out_dag->parents = malloc(sizeof(vertex_t) * (offsets[vertex_len] + 1));
+    if (out_dag->parents == NULL) {
+        free(queue);
+        bfs_dag_destroy(out_dag);
+        return;
+    }
+
+    for (size_t k = 1; k < queue_tail; k++) {
+        vertex_t j = queue[k];
+        size_t pos = offsets[j];
+
+        struct gneighbor_iterator it = {0};
+        graph_neighbors(graph, j, &it);
+
+        for (vertex_t i = 0; gneighbor_next(&it, &i, NULL);) {
+            if (hops[i] != VERTEX_T_MAX && hops[i] + 1 == hops[j]) {
+                out_dag->parents[pos++] = i;
+            }
+        }
+    }
+
+    free(queue);
+}
+
+void graph_short_path(struct graph* graph,
+                      vertex_t start_vertex,
+                      vertex_t end_vertex,
+                      u32vertices_map* out_map) {
+    if (out_map == NULL || !g_initial_path(graph, start_vertex, end_vertex)) {
+        return;
+    }
+
+    hashmap_init(out_map, 0, u32vertices_destroyer);
+    mkey_t next_key = 0;
+
+    struct short_path_iter it = {0};
+    if (!short_path_iter_init(&it, graph, start_vertex, end_vertex)) {
+        return;
+    }
+
+    for (size_t len = 0; (len = short_path_iter_next(&it, NULL, 0)) > 0;) {
+        struct vertex_array* vertices = calloc(1, sizeof(struct vertex_array));
+        vertex_array_reserve(vertices, len);
+        vertices->len = short_path_iter_next(&it, vertices->data, len);
+
+        hashmap_put(out_map, next_key++, vertices);
+    }
+
+    short_path_iter_destroy(&it);
+}
+
+bool short_path_iter_init(struct short_path_iter* it,
+                          const struct graph* graph,
+                          vertex_t start_vertex,
+                          vertex_t end_vertex) {
+    if (it == NULL) {
+        return false;
+    }
+
+    *it = (struct short_path_iter) {0};
+    if (g_is_out(graph, start_vertex, end_vertex)) {
+        return false;
+    }
+
+    it->graph = graph;
+    it->end_vertex = end_vertex;
+
+    graph_bfs_dag(graph, start_vertex, end_vertex, &it->dag);
+    if (it->dag.len == 0) {
+        return false;
+    }
+
+    it->hops = bfs_dag_hops(&it->dag, end_vertex);
+    it->done = it->hops == VERTEX_T_MAX || it->hops == 0;
+    if (it->done) {
+        return true;
+    }
+
+    size_t hops = it->hops;
+
+    it->leads = calloc(bitset_words(it->dag.len), sizeof(uint64_t));
+    it->vertices = malloc(sizeof(vertex_t) * (hops + 1));
+    it->its = calloc(hops + 1, sizeof(struct gneighbor_iterator));
+
+    // the vertices that lead to the destination vertex, the
+    // others are pruned from the walk
+    struct vertex_array stack = {0};
+    bool ready = it->leads != NULL && it->vertices != NULL && it->its != NULL;
+
+    if (ready) {
+        bitset_set(it->leads, end_vertex);
+        vertex_array_reserve(&stack, 1);
+        stack.data[stack.len++] = end_vertex;
+    }
+
+    while (stack.len > 0) {
+        size_t len = 0;
+        const vertex_t* parents = bfs_dag_parents(&it->dag, stack.data[--stack.len], &len);
+
+        for (size_t k = 0; k < len; k++) {
+            if (bitset_get(it->leads, parents[k])) {
+                continue;
+            }
+
+            bitset_set(it->leads, parents[k]);
+            if (stack.len >= stack.capacity) {
+                vertex_array_reserve(&stack, stack.capacity);
+            }
+            stack.data[stack.len++] = parents[k];
+        }
+    }
+
+    vertex_array_destroy(&stack);
+
+    if (!ready) {
+        short_path_iter_destroy(it);
+        return false;
+    }
+
+    it->vertices[0] = start_vertex;
+    graph_neighbors(graph, start_vertex, &it->its[0]);
+
+    return true;
+}
+
+size_t short_path_iter_next(struct short_path_iter* it, vertex_t* out_vertices, size_t capacity) {
+    if (it == NULL || it->done) {
+        return 0;
+    }
+
+    size_t len = (size_t) it->hops + 1;
+
+    // walk forward the layers in the order of the neighbors,
+    // until the destination vertex closes a path
+    while (!it->pending) {
+        vertex_t j = 0;
+        bool found = false;
+
+        while (!found && gneighbor_next(&it->its[it->depth], &j, NULL)) {
+            found = it->dag.hops[j] == it->depth + 1 && bitset_get(it->leads, j);
+        }
+
+        if (!found) {
+            if (it->depth == 0) {
+                it->done = true;
+                return 0;
+            }
+
+            it->depth--;
+            continue;
+        }
+
+        it->vertices[it->depth + 1] = j;
+
+        if (j == it->end_vertex) {
+            it->pending = true;
+        } else {
+            it->depth++;
+            graph_neighbors(it->graph, j, &it->its[it->depth]);
+        }
+    }
+
+    if (out_vertices == NULL || capacity < len) {
+        return len;
+    }
+
+    memcpy(out_vertices, it->vertices, sizeof(vertex_t) * len);
+    it->pending = false;
+
+    return len;
+}
+
+void short_path_iter_destroy(struct short_path_iter* it) {
+    if (it == NULL) {
+        return;
+    }
+
+    bfs_dag_destroy(&it->dag);
+    free(it->leads);
+    free(it->vertices);
+    free(it->its);
+
+    *it = (struct short_path_iter) {0};
+}
+
+uint64_t graph_short_path_count(const struct graph* graph, vertex_t start_vertex, vertex_t end_vertex) {
+    if (g_is_out(graph, start_vertex, end_vertex) || start_vertex == end_vertex) {
+        return 0;
+    }
+
+    size_t vertex_len = graph->len;
+
+    vertex_t* hops = malloc(sizeof(vertex_t) * vertex_len);
+    uint64_t* counts = calloc(vertex_len, sizeof(uint64_t));
+    vertex_t* queue = malloc(sizeof(vertex_t) * vertex_len);
+
+    if (hops == NULL || counts == NULL || queue == NULL) {
+        free(hops);
+        free(counts);
+        free(queue);
+        return 0;
+    }
+
+    for (size_t v = 0; v < vertex_len; v++) {
+        hops[v] = VERTEX_T_MAX;
+    }
+
+    size_t queue_head = 0;
+    size_t queue_tail = 0;
+
+    queue[queue_tail++] = start_vertex;
+    hops[start_vertex] = 0;
+    counts[start_vertex] = 1;
+
+    while (queue_head < queue_tail) {
+        vertex_t i = queue[queue_head++];
+
+        // the parents of the destination vertex are all in the
+        // previous layer, so its count is complete
+        if (hops[end_vertex] != VERTEX_T_MAX && hops[i] >= hops[end_vertex]) {
+            break;
+        }
+
+        struct gneighbor_iterator it = {0};
+        graph_neighbors(graph, i, &it);
+
+        for (vertex_t j = 0; gneighbor_next(&it, &j, NULL);) {
+            if (hops[j] == VERTEX_T_MAX) {
+                hops[j] = hops[i] + 1;
+                queue[queue_tail++] = j;
+            } else if (hops[j] != hops[i] + 1) {
+                continue;
+            }
+
+            // it saturates instead of wrapping around
+            uint64_t count = counts[j] + counts[i];
+            counts[j] = count < counts[j] ? UINT64_MAX : count;
+        }
+    }
+
+    uint64_t count = counts[end_vertex];
+
+    free(hops);
+    free(counts);
+    free(queue);
+
+    return count;
+}
+
+void graph_sssp(struct graph* graph,
+                vertex_t start_vertex,
+                vertex_t end_vertex,
+                struct sssp_tree* out_tree) {
+    if (out_tree == NULL) {
+        return;
+    }
+
+    *out_tree = (struct sssp_tree) {0};
+    if (g_is_out(graph, start_vertex, start_vertex)) {
+        return;
+    }
+
+    size_t vertex_len = graph->len;
+    if (!sssp_tree_init(out_tree, vertex_len, start_vertex)) {
+        return;
+    }
+
+    distance_t* distances = out_tree->distances;
+    vertex_t* parents = out_tree->parents;
+
+    // the vertices whose distance is final
+    uint64_t* settled = calloc(bitset_words(vertex_len), sizeof(uint64_t));
+
+    // small integer weights keep every queued distance in a
+    // short window, so a bucket for each distance beats
+    // comparing them, the narrow weights are unsigned and the
+    // 8 bits ones always fit
+#if WEIGHT_FLOAT
+    bool dial = false;
+#elif WEIGHT_BITS == 8
+    bool dial = true;
+#elif WEIGHT_BITS == 16
+    bool dial = graph->max_weight <= GRAPH_DIAL_MAX_WEIGHT;
+#else
+    bool dial = graph->max_weight >= 0 && graph->max_weight <= GRAPH_DIAL_MAX_WEIGHT;
+#endif
+
+    struct heap_vertex heap = {0};
+    struct heap_dial buckets = {0};
+
+    bool queued = dial ? heap_dial_init(&buckets, vertex_len, (size_t) graph->max_weight)
+                       : heap_vertex_init(&heap, vertex_len);
+
+    if (settled == NULL || !queued) {
+        free(settled);
+        heap_vertex_destroy(&heap);
+        heap_dial_destroy(&buckets);
+        sssp_tree_destroy(out_tree);
+        return;
+    }
+
+    if (dial) {
+        heap_dial_push(&buckets, start_vertex, 0);
+    } else {
+        heap_vertex_push(&heap, start_vertex, 0);
+    }
+
+    // the distance of the target once it's settled, the
+    // vertices as far as it are settled as well, so the kept
+    // ones don't depend on the order of the ties in the queue
+    distance_t limit = DISTANCE_MAX;
+
+    while (dial ? !heap_dial_empty(&buckets) : !heap_vertex_empty(&heap)) {
+        vertex_t i = dial ? heap_dial_pop(&buckets, NULL) : heap_vertex_pop(&heap, NULL);
+        if (distances[i] > limit) {
+            break;
+        }
+
+        bitset_set(settled, i);
+        if (i == end_vertex) {
+            limit = distances[i];
+        }
+
+        struct gneighbor_iterator it = {0};
+        graph_neighbors(graph, i, &it);
+        it.mask = settled;
+
+        // the weight of edge <i, j>
+        weight_t weight = 0;
+
+        for (vertex_t j = 0; gneighbor_next(&it, &j, &weight);) {
+            distance_t distance = distances[i] + weight;
+
+            if (distance < distances[j]) {
+                distances[j] = distance;
+                parents[j] = i;
+
+                if (dial) {
+                    heap_dial_push(&buckets, j, distance);
+                } else {
+                    heap_vertex_push(&heap, j, distance);
+                }
+            } else if (distance == distances[j] && distances[i] < distance
+                       && (distances[parents[j]] == distance || i < parents[j])) {
+                // a tie keeps the lowest parent from a lower
+                // distance, they're all settled before j
+                parents[j] = i;
+            }
+        }
+    }
+
+    // the queued vertices weren't settled, so their paths
+    // may not be minimal
+    for (vertex_t i = 0; i < vertex_len; i++) {
+        if (distances[i] != DISTANCE_MAX && !bitset_get(settled, i)) {
+            distances[i] = DISTANCE_MAX;
+            parents[i] = VERTEX_T_MAX;
+        }
+    }
+
+    free(settled);
+    heap_vertex_destroy(&heap);
+    heap_dial_destroy(&buckets);
+
+    graph_sssp_ties(graph, out_tree);
+}
+
+void graph_sssp_ties(const struct graph* graph, struct sssp_tree* tree) {
+    if (graph == NULL || tree == NULL || tree->len == 0) {
+        return;
+    }
+
+    size_t vertex_len = tree->len;
+    const distance_t* distances = tree->distances;
+    vertex_t* parents = tree->parents;
+
+    // the vertices whose parent is as far as them, they were
+    // reached just by zero weight edges
+    bool found = false;
+    for (vertex_t v = 0; v < vertex_len && !found; v++) {
+        found = parents[v] != VERTEX_T_MAX && distances[parents[v]] == distances[v];
+    }
+
+    if (!found) {
+        return;
+    }
+
+    // the length of zero weight edges back to a vertex reached
+    // from a lower distance, VERTEX_T_MAX if it's not known
+    vertex_t* hops = malloc(sizeof(vertex_t) * vertex_len);
+    vertex_t* queue = malloc(sizeof(vertex_t) * vertex_len);
+    if (hops == NULL || queue == NULL) {
+        free(hops);
+        free(queue);
+        return;
+    }
+
+    for (vertex_t v = 0; v < vertex_len; v++) {
+        bool zero = parents[v] != VERTEX_T_MAX && distances[parents[v]] == distances[v];
+        hops[v] = distances[v] == DISTANCE_MAX || zero ? VERTEX_T_MAX : 0;
+    }
+
+    size_t queue_len = 0;
+
+    // the first layer is linked to the others
+    for (vertex_t v = 0; v < vertex_len; v++) {
+        if (hops[v] != VERTEX_T_MAX || distances[v] == DISTANCE_MAX) {
+            continue;
+        }
+
+        struct gneighbor_iterator it = {0};
+        graph_neighbors(graph, v, &it);
+
+        vertex_t parent = VERTEX_T_MAX;
+        weight_t weight = 0;
+
+        for (vertex_t u = 0; gneighbor_next(&it, &u, &weight);) {
+            if (hops[u] == 0 && distances[u] == distances[v] && distances[u] + weight == distances[v] && u < parent) {
+                parent = u;
+            }
+        }
+
+        if (parent != VERTEX_T_MAX) {
+            parents[v] = parent;
+            queue[queue_len++] = v;
+        }
+    }
+
+    for (size_t k = 0; k < queue_len; k++) {
+        hops[queue[k]] = 1;
+    }
+
+    // every layer is settled before the next one, so the
+    // lowest parent of the previous layer is kept
+    for (size_t head = 0; head < queue_len; head++) {
+        vertex_t u = queue[head];
+
+        struct gneighbor_iterator it = {0};
+        graph_neighbors(graph, u, &it);
+
+        weight_t weight = 0;
+        for (vertex_t v = 0; gneighbor_next(&it, &v, &weight);) {
+            if (distances[v] != distances[u] || distances[u] + weight != distances[v]) {
+                continue;
+            }
+
+            if (hops[v] == VERTEX_T_MAX) {
+                hops[v] = hops[u] + 1;
+                parents[v] = u;
+                queue[queue_len++] = v;
+            } else if (hops[v] == hops[u] + 1 && u < parents[v]) {
+                parents[v] = u;
+            }
+        }
+    }
+
+    free(hops);
+    free(queue);
+}
+
+void graph_minimal_path(struct graph* graph,
+                        vertex_t start_vertex,
+                        vertex_t end_vertex,
+                        u32path_map* out_map) {
+    if (out_map == NULL) {
+        return;
+    }
+    if (end_vertex != VERTEX_T_MAX && !g_initial_path(graph, start_vertex, end_vertex)) {
+        return;
+    }
+
+    struct sssp_tree tree = {0};
+    graph_sssp(graph, start_vertex, end_vertex, &tree);
+
+    g_tree_paths(&tree, out_map);
+    sssp_tree_destroy(&tree);
+}
+
+static void g_tree_paths(const struct sssp_tree* tree, u32path_map* out_map) {
+    if (tree->len == 0) {
+        return;
+    }
+
+    // now add all found paths in a map, the source vertex is
+    // ignored
+    hashmap_init(out_map, 0, u32path_destroyer);
+
+    for (vertex_t i = 0; i < tree->len; i++) {
+        size_t len = sssp_tree_path(tree, i, NULL, 0);
+        if (len <= 1) {
+            continue;
+        }
+
+        struct path* path = calloc(1, sizeof(struct path));
+        path->weight = tree->distances[i];
+
+        vertex_array_reserve(&path->vertices, len);
+        path->vertices.len = sssp_tree_path(tree, i, path->vertices.data, len);
+
+        hashmap_put(out_map, i, path);
+    }
+}
+
+void graph_minimal_path_mode(struct graph* graph,
+                             vertex_t start_vertex,
+                             vertex_t end_vertex,
+                             enum graph_path_mode mode,
+                             u32path_map* out_map) {
+    if (mode == GRAPH_PATH_DELTA_STEPPING) {
+        if (out_map == NULL || (end_vertex != VERTEX_T_MAX && !g_initial_path(graph, start_vertex, end_vertex))) {
+            return;
+        }
+
+        struct sssp_tree tree = {0};
+        graph_sssp_delta(graph, start_vertex, end_vertex, 0, 0, &tree);
+
+        g_tree_paths(&tree, out_map);
+        sssp_tree_destroy(&tree);
+        return;
+    }
+    if (mode == GRAPH_PATH_DIJKSTRA || end_vertex == VERTEX_T_MAX) {
+        graph_minimal_path(graph, start_vertex, end_vertex, out_map);
+        return;
+    }
+    if (out_map == NULL || !g_initial_path(graph, start_vertex, end_vertex)) {
+        return;
+    }
+
+    hashmap_init(out_map, 0, u32path_destroyer);
+
+    // the source vertex doesn't have a path to itself
+    if (start_vertex == end_vertex) {
+        return;
+    }
+
+    struct path* path = calloc(1, sizeof(struct path));
+    bool found = false;
+
+    if (mode == GRAPH_PATH_ALT) {
+        const struct glandmarks* landmarks = graph->cache.landmarks;
+        if (landmarks == NULL) {
+            graph_landmarks(graph, GRAPH_ALT_LANDMARKS, &landmarks);
+        }
+
+        found = landmarks != NULL && g_alt_path(graph, landmarks, start_vertex, end_vertex, path);
+    } else {
+        found = g_bidirectional_path(graph, start_vertex, end_vertex, path);
+    }
+
+    if (!found) {
+        free(path);
+        return;
+    }
+
+    hashmap_put(out_map, end_vertex, path);
+}
+
+void graph_landmarks(struct graph* graph, size_t k, const struct glandmarks** out_landmarks) {
+    if (graph == NULL) {
+        return;
+    }
+
+    size_t vertex_len = graph->len;
+    if (k > vertex_len) {
+        k = vertex_len;
+    }
+
+    struct glandmarks* landmarks = graph->cache.landmarks;
+    // check if the landmarks were already picked, the clamped
+    // length is compared since fewer ones may have been found
+    if (landmarks != NULL && landmarks->requested == k) {
+        if (out_landmarks != NULL) {
+            *out_landmarks = landmarks;
+        }
+
+        return;
+    }
+
+    g_invalidate_landmarks(graph);
+
+    landmarks = calloc(1, sizeof(struct glandmarks));
+    if (landmarks == NULL) {
+        return;
+    }
+
+    landmarks->requested = k;
+    landmarks->vertex_len = vertex_len;
+    landmarks->vertices = malloc(sizeof(vertex_t) * (k + 1));
+    landmarks->distances = malloc(sizeof(distance_t) * (k * vertex_len + 1));
+
+    // the distance from each vertex to the nearest landmark,
+    // where DISTANCE_MAX means that no landmark reaches it
+    distance_t* nearest = malloc(sizeof(distance_t) * (vertex_len + 1));
+
+    if (landmarks->vertices == NULL || landmarks->distances == NULL || nearest == NULL) {
+        glandmarks_destroy(landmarks);
+        free(landmarks);
+        free(nearest);
+        return;
+    }
+
+    // the distances from an arbitrary vertex are the first
+    // ones, its farthest vertex is the first landmark
+    vertex_t seed = 0;
+    while (seed < vertex_len && graph->degree.degrees[seed] == 0) {
+        seed++;
+    }
+
+    struct sssp_tree tree = {0};
+    graph_sssp(graph, seed, VERTEX_T_MAX, &tree);
+
+    for (vertex_t v = 0; v < vertex_len; v++) {
+        nearest[v] = tree.len > 0 ? tree.distances[v] : DISTANCE_MAX;
+    }
+
+    sssp_tree_destroy(&tree);
+
+    while (landmarks->len < k) {
+        // look for the farthest vertex, an unreached one is the
+        // farthest such that every component gets a landmark,
+        // but the isolated vertices don't need any bound
+        vertex_t farthest = VERTEX_T_MAX;
+
+        for (vertex_t v = 0; v < vertex_len; v++) {
+            if (graph->degree.degrees[v] == 0) {
+                continue;
+            }
+            if (farthest == VERTEX_T_MAX || nearest[v] > nearest[farthest]) {
+                farthest = v;
+            }
+        }
+
+        // every vertex is a landmark already
+        if (farthest == VERTEX_T_MAX || (landmarks->len > 0 && nearest[farthest] == 0)) {
+            break;
+        }
+
+        graph_sssp(graph, farthest, VERTEX_T_MAX, &tree);
+        if (tree.len == 0) {
+            break;
+        }
+
+        distance_t* distances = &landmarks->distances[landmarks->len * vertex_len];
+        memcpy(distances, tree.distances, sizeof(distance_t) * vertex_len);
+        sssp_tree_destroy(&tree);
+
+        for (vertex_t v = 0; v < vertex_len; v++) {
+            // the previous landmarks don't matter for the first
+            // one, it just came from the seed
+            if (landmarks->len == 0 || distances[v] < nearest[v]) {
+                nearest[v] = distances[v];
+            }
+        }
+
+        landmarks->vertices[landmarks->len++] = farthest;
+    }
+
+    free(nearest);
+    graph->cache.landmarks = landmarks;
+
+    if (out_landmarks != NULL) {
+        *out_landmarks = landmarks;
+    }
+}
+
+void glandmarks_destroy(struct glandmarks* landmarks) {
+    if (landmarks == NULL) {
+        return;
+    }
+
+    free(landmarks->vertices);
+    free(landmarks->distances);
+
+    landmarks->len = 0;
+    landmarks->requested = 0;
+    landmarks->vertex_len = 0;
+    landmarks->vertices = NULL;
+    landmarks->distances = NULL;
+}
+
+void gcomponent_destroy(struct gcomponent* comp) {
+    if (comp == NULL) {
+        return;
+    }
+
+    free(comp->array.data);
+    comp->array.len = 0;
+    comp->array.data = NULL;
+
+    hashmap_destroy(&comp->map);
+}
+
+static inline weight_t g_empty_weight(const struct graph* graph) {
+    if (graph == NULL) {
+        return 0;
+    }
+
+    return graph->weighted ? NONE_WEIGHT_VALUE : 0;
+}
+
+static inline weight_t* g_row(const struct graph* graph, vertex_t vi) {
+    return &graph->matrix[vi * graph->stride];
+}
+
+static inline uint64_t* g_bits(const struct graph* graph, vertex_t vi) {
+    return &graph->bits[vi * graph->words];
+}
+
+static inline weight_t* g_triangle(const struct graph* graph, vertex_t vi, vertex_t wj) {
+    if (vi > wj) {
+        vertex_t k = vi;
+        vi = wj;
+        wj = k;
+    }
+
+    return &graph->triangle[wj * (wj + 1) / 2 + vi];
+}
+
+static inline bool g_is_out(const struct graph* graph, vertex_t vi, vertex_t wj) {
+    if (graph == NULL || vi >= graph->len || wj >= graph->len) {
+        return true;
+    }
+
+    const uint64_t* removed = graph->removed;
+    return removed != NULL && (bitset_get(removed, vi) || bitset_get(removed, wj));
+}
+
+static bool g_bidirectional_path(struct graph* graph,
+                                 vertex_t start_vertex,
+                                 vertex_t end_vertex,
+                                 struct path* out_path) {
+    size_t vertex_len = graph->len;
+
+    // the forward search is the side 0 and the backward one is
+    // the side 1, the graph is undirected so both of them
+    // follow the same edges
+    struct sssp_tree trees[2] = {0};
+    struct heap_vertex heaps[2] = {0};
+    uint64_t* settled[2] = {0};
+
+    vertex_t sources[2] = {start_vertex, end_vertex};
+    bool ready = true;
+
+    for (int side = 0; side < 2; side++) {
+        ready = ready && sssp_tree_init(&trees[side], vertex_len, sources[side]);
+        ready = ready && heap_vertex_init(&heaps[side], vertex_len);
+
+        settled[side] = calloc(bitset_words(vertex_len), sizeof(uint64_t));
+        ready = ready && settled[side] != NULL;
+    }
+
+    // the weakest path found where both searches meet
+    distance_t best = DISTANCE_MAX;
+    vertex_t meet = VERTEX_T_MAX;
+
+    if (ready) {
+        heap_vertex_push(&heaps[0], start_vertex, 0);
+        heap_vertex_push(&heaps[1], end_vertex, 0);
+    }
+
+    while (ready && !heap_vertex_empty(&heaps[0]) && !heap_vertex_empty(&heaps[1])) {
+        distance_t forward_key = heap_vertex_top(&heaps[0]);
+        distance_t backward_key = heap_vertex_top(&heaps[1]);
+
+        // any path through an unsettled vertex is at least as
+        // heavy as both keys
+        if (forward_key + backward_key >= best) {
+            break;
+        }
+
+        int side = forward_key <= backward_key ? 0 : 1;
+        distance_t* distances = trees[side].distances;
+        const distance_t* other_distances = trees[1 - side].distances;
+
+        vertex_t i = heap_vertex_pop(&heaps[side], NULL);
+        bitset_set(settled[side], i);
+
+        struct gneighbor_iterator it = {0};
+        graph_neighbors(graph, i, &it);
+        it.mask = settled[side];
+
+        weight_t weight = 0;
+
+        for (vertex_t j = 0; gneighbor_next(&it, &j, &weight);) {
+            distance_t distance = distances[i] + weight;
+
+            if (distance < distances[j]) {
+                distances[j] = distance;
+                trees[side].parents[j] = i;
+                heap_vertex_push(&heaps[side], j, distance);
+            }
+
+            // j was reached by the other search, so there is a
+            // path through the edge <i, j>
+            if (other_distances[j] != DISTANCE_MAX && distances[j] + other_distances[j] < best) {
+                best = distances[j] + other_distances[j];
+                meet = j;
+            }
+        }
+    }
+
+    bool found = meet != VERTEX_T_MAX;
+
+    if (found) {
+        size_t forward_len = sssp_tree_path(&trees[0], meet, NULL, 0);
+        size_t backward_len = sssp_tree_path(&trees[1], meet, NULL, 0);
+        // the meeting vertex is in both halves
+        size_t len = forward_len + backward_len - 1;
+
+        vertex_array_reserve(&out_path->vertices, len);
+        out_path->vertices.len = len;
+        out_path->weight = best;
+
+        vertex_t* data = out_path->vertices.data;
+        sssp_tree_path(&trees[0], meet, data, forward_len);
+
+        // the backward half goes from the destination vertex
+        // to the meeting one, so it's written reversed
+        vertex_t v = meet;
+        for (size_t k = forward_len - 1; k < len; k++, v = trees[1].parents[v]) {
+            data[k] = v;
+        }
+    }
+
+    for (int side = 0; side < 2; side++) {
+        sssp_tree_destroy(&trees[side]);
+        heap_vertex_destroy(&heaps[side]);
+        free(settled[side]);
+    }
+
+    return found;
+}
+
+static bool g_alt_path(struct graph* graph,
+                       const struct glandmarks* landmarks,
+                       vertex_t start_vertex,
+                       vertex_t end_vertex,
+                       struct path* out_path) {
+    size_t vertex_len = graph->len;
+
+    struct sssp_tree tree = {0};
+    struct heap_vertex heap = {0};
+    uint64_t* settled = calloc(bitset_words(vertex_len), sizeof(uint64_t));
+
+    if (settled == NULL || !sssp_tree_init(&tree, vertex_len, start_vertex) || !heap_vertex_init(&heap, vertex_len)) {
+        free(settled);
+        sssp_tree_destroy(&tree);
+        return false;
+    }
+
+    distance_t* distances = tree.distances;
+    bool found = false;
+
+    // the key of a vertex is its distance plus the lower
+    // bound until the destination vertex
+    heap_vertex_push(&heap, start_vertex, g_alt_bound(landmarks, start_vertex, end_vertex));
+
+    while (!heap_vertex_empty(&heap)) {
+        vertex_t i = heap_vertex_pop(&heap, NULL);
+        bitset_set(settled, i);
+
+        if (i == end_vertex) {
+            found = true;
+            break;
+        }
+
+        struct gneighbor_iterator it = {0};
+        graph_neighbors(graph, i, &it);
+        it.mask = settled;
+
+        weight_t weight = 0;
+
+        for (vertex_t j = 0; gneighbor_next(&it, &j, &weight);) {
+            distance_t distance = distances[i] + weight;
+
+            if (distance < distances[j]) {
+                distances[j] = distance;
+                tree.parents[j] = i;
+                heap_vertex_push(&heap, j, distance + g_alt_bound(landmarks, j, end_vertex));
+            }
+        }
+    }
+
+    if (found) {
+        size_t len = sssp_tree_path(&tree, end_vertex, NULL, 0);
+
+        vertex_array_reserve(&out_path->vertices, len);
+        out_path->vertices.len = sssp_tree_path(&tree, end_vertex, out_path->vertices.data, len);
+        out_path->weight = distances[end_vertex];
+    }
+
+    free(settled);
+    sssp_tree_destroy(&tree);
+    heap_vertex_destroy(&heap);
+
+    return found;
+}
+
+static distance_t g_alt_bound(const struct glandmarks* landmarks, vertex_t vi, vertex_t wj) {
+    distance_t bound = 0;
+
+    for (size_t l = 0; l < landmarks->len; l++) {
+        const distance_t* distances = &landmarks->distances[l * landmarks->vertex_len];
+        distance_t vi_distance = distances[vi];
+        distance_t wj_distance = distances[wj];
+
+        if (vi_distance == DISTANCE_MAX || wj_distance == DISTANCE_MAX) {
+            continue;
+        }
+
+        distance_t difference = vi_distance > wj_distance ? vi_distance - wj_distance : wj_distance - vi_distance;
+        if (difference > bound) {
+            bound = difference;
+        }
+    }
+
+    return bound;
+}
+
+static void* g_aligned_alloc(size_t size) {
+    void* block = NULL;
+    if (posix_memalign(&block, ROW_ALIGNMENT, size > 0 ? size : ROW_ALIGNMENT) != 0) {
+        return NULL;
+    }
+
+    return block;
+}
+
+static void g_dense_neighbor_init(struct gneighbor_iterator* it) {
+    it->pos = 0;
+    it->end = it->graph->len;
+}
+
+static bool g_matrix_reserve(struct graph* graph, size_t capacity) {
+    if (capacity <= graph->capacity && graph->matrix != NULL) {
+        return true;
+    }
+
+    size_t len = graph->len;
+    weight_t empty_weight = g_empty_weight(graph);
+
+    // the whole matrix is a single aligned block, such that
+    // every row starts in a cache line
+    size_t stride = row_stride(capacity);
+    weight_t* matrix = g_aligned_alloc(sizeof(weight_t) * stride * capacity);
+    if (matrix == NULL) {
+        return false;
+    }
+
+    // the reserved cells, including the padding of rows, have
+    // the default value of graph
+    for (size_t k = 0; k < stride * capacity; k++) {
+        matrix[k] = empty_weight;
+    }
+    for (vertex_t i = 0; i < len; i++) {
+        memcpy(&matrix[i * stride], g_row(graph, i), sizeof(weight_t) * len);
+    }
+
+    free(graph->matrix);
+    graph->matrix = matrix;
+    graph->stride = stride;
+    graph->capacity = capacity;
+
+    return true;
+}
+
+static void g_matrix_destroy(struct graph* graph) {
+    free(graph->matrix);
+
+    graph->stride = 0;
+    graph->matrix = NULL;
+}
+
+static bool g_matrix_has(const struct graph* graph, vertex_t vi, vertex_t wj) {
+    return g_row(graph, vi)[wj] != g_empty_weight(graph);
+}
+
+static weight_t g_matrix_get(const struct graph* graph, vertex_t vi, vertex_t wj) {
+    return g_row(graph, vi)[wj];
+}
+
+static void g_matrix_set(struct graph* graph, vertex_t vi, vertex_t wj, weight_t weight) {
+    g_row(graph, vi)[wj] = weight;
+    g_row(graph, wj)[vi] = weight;
+}
+
+static void g_matrix_del(struct graph* graph, vertex_t vi, vertex_t wj) {
+    g_matrix_set(graph, vi, wj, g_empty_weight(graph));
+}
+
+static size_t g_matrix_degree(const struct graph* graph, vertex_t vi) {
+    // the padding is filled with the empty weight, so the
+    // whole stride can be scanned without a scalar tail
+    return row_count(g_row(graph, vi), graph->stride, g_empty_weight(graph));
+}
+
+static bool g_matrix_neighbor_next(struct gneighbor_iterator* it, vertex_t* out_vertex, weight_t* out_weight) {
+    const struct graph* graph = it->graph;
+    const uint64_t* mask = it->mask;
+
+    weight_t empty_weight = g_empty_weight(graph);
+    const weight_t* row = g_row(graph, it->vertex);
+
+    while (it->pos < it->end) {
+        size_t pos = row_find(row, it->pos, it->end, empty_weight);
+        if (pos >= it->end) {
+            break;
+        }
+
+        it->pos = pos + 1;
+        if (mask != NULL && bitset_get(mask, pos)) {
+            continue;
+        }
+
+        *out_vertex = pos;
+        if (out_weight != NULL) {
+            *out_weight = row[pos];
+        }
+
+        return true;
+    }
+
+    it->pos = it->end;
+    return false;
+}
 
-        if (vertices->data[vertices->len - 1] != end_vertex) {
-            continue;
+static bool g_csr_reserve(struct graph* graph, size_t capacity) {
+    if (!gcsr_reserve(&graph->csr, capacity)) {
+        return false;
+    }
+
+    // the reserved vertices are kept as empty runs at the end,
+    // so the vertices that are added already have their row
+    while (graph->csr.len < capacity) {
+        if (gcsr_add_vertex(&graph->csr) == VERTEX_T_MAX) {
+            return false;
         }
+    }
+
+    graph->capacity = capacity;
+    return true;
+}
+
+static void g_csr_destroy(struct graph* graph) {
+    gcsr_destroy(&graph->csr);
+}
+
+static void g_csr_build(struct graph* graph, size_t len, const struct edge* edges, size_t edge_len) {
+    gcsr_init(&graph->csr, graph->weighted, len, edges, edge_len);
+
+    graph->len = len;
+    graph->capacity = len;
+}
+
+static bool g_csr_has(const struct graph* graph, vertex_t vi, vertex_t wj) {
+    return gcsr_find(&graph->csr, vi, wj, NULL);
+}
 
-        struct vertex_array* clone_vertices = calloc(1, sizeof(struct vertex_array));
-        vertex_array_clone(&path->vertices, clone_vertices);
-        hashmap_put(out_map, next_key++, clone_vertices);
+static weight_t g_csr_get(const struct graph* graph, vertex_t vi, vertex_t wj) {
+    size_t pos = 0;
+    if (!gcsr_find(&graph->csr, vi, wj, &pos)) {
+        return g_empty_weight(graph);
     }
 
-    hashmap_destroy(&paths);
-    wave_destroy(&root_wave);
+    return graph->csr.weights[pos];
 }
 
-void graph_minimal_path(struct graph* graph,
-                          vertex_t start_vertex,
-                          vertex_t end_vertex,
-                          u32path_map* out_map) {
-    if (out_map == NULL) {
-        return;
+static void g_csr_set(struct graph* graph, vertex_t vi, vertex_t wj, weight_t weight) {
+    bool linked = gcsr_find(&graph->csr, vi, wj, NULL);
+
+    // a half edge is undone, so the edge is set in both
+    // directions or it's not added at all
+    if (gcsr_set(&graph->csr, vi, wj, weight) && !gcsr_set(&graph->csr, wj, vi, weight) && !linked) {
+        gcsr_del(&graph->csr, vi, wj);
     }
-    if (end_vertex != VERTEX_T_MAX && !g_initial_path(graph, start_vertex, end_vertex)) {
-        return;
+}
+
+static void g_csr_del(struct graph* graph, vertex_t vi, vertex_t wj) {
+    gcsr_del(&graph->csr, vi, wj);
+    gcsr_del(&graph->csr, wj, vi);
+}
+
+static size_t g_csr_degree(const struct graph* graph, vertex_t vi) {
+    return gcsr_degree(&graph->csr, vi);
+}
+
+static void g_csr_neighbor_init(struct gneighbor_iterator* it) {
+    const struct gcsr* csr = &it->graph->csr;
+
+    it->pos = csr->offsets[it->vertex];
+    it->end = csr->offsets[it->vertex + 1];
+}
+
+static bool g_csr_neighbor_next(struct gneighbor_iterator* it, vertex_t* out_vertex, weight_t* out_weight) {
+    const struct gcsr* csr = &it->graph->csr;
+    const uint64_t* mask = it->mask;
+
+    for (; it->pos < it->end; it->pos++) {
+        vertex_t j = csr->neighbors[it->pos];
+        if (mask != NULL && bitset_get(mask, j)) {
+            continue;
+        }
+
+        *out_vertex = j;
+        if (out_weight != NULL) {
+            *out_weight = csr->weights[it->pos];
+        }
+
+        it->pos++;
+        return true;
     }
 
-    const struct gcomponent* component = NULL;
-    graph_components(graph, &component);
-    if (component == NULL) {
-        return;
+    return false;
+}
+
+static bool g_bitset_reserve(struct graph* graph, size_t capacity) {
+    if (capacity <= graph->capacity && graph->bits != NULL) {
+        return true;
     }
 
-    size_t vertex_len = graph->len;
+    size_t len = graph->len;
 
-    bool* visited = calloc(vertex_len, sizeof(bool));
-    // allow to track the minimal weight that given vertex
-    // can can have, including its path
-    struct path* minimal_paths = calloc(vertex_len, sizeof(struct path));
+    // rows are padded up to a cache line such as the matrix
+    size_t line_words = ROW_ALIGNMENT / sizeof(uint64_t);
+    size_t words = (bitset_words(capacity) + line_words - 1) / line_words * line_words;
 
-    // initialize with an invalid weight
-    // (the maximum possible / infinity)
-    for (size_t i = 0; i < vertex_len; i++) {
-        struct path* path = &minimal_paths[i];
+    uint64_t* bits = g_aligned_alloc(sizeof(uint64_t) * words * capacity);
+    if (bits == NULL) {
+        return false;
+    }
 
-        path_init(path, NULL);
-        path->weight = INT32_MAX;
+    memset(bits, 0, sizeof(uint64_t) * words * capacity);
+    for (vertex_t i = 0; i < len; i++) {
+        memcpy(&bits[i * words], g_bits(graph, i), sizeof(uint64_t) * graph->words);
     }
 
-    // create an initial path for the source vertex
-    // and add it in minimal_paths
-    struct vertex_array initial_vertex = {0};
-    vertex_array_from(&initial_vertex, (vertex_t[1]){start_vertex}, 1);
+    free(graph->bits);
+    graph->bits = bits;
+    graph->words = words;
+    graph->capacity = capacity;
 
-    struct path* start_path = &minimal_paths[start_vertex];
-    path_init(start_path, &initial_vertex);
-    start_path->weight = 0;
+    return true;
+}
 
-    struct queue_vertex queue = {0};
-    queue_vertex_init(&queue);
-    queue_vertex_add(&queue, start_vertex);
+static void g_bitset_destroy(struct graph* graph) {
+    free(graph->bits);
 
-    while (!queue_vertex_empty(&queue)) {
-        vertex_t i = queue_vertex_del(&queue);
-        if (i == end_vertex) {
+    graph->words = 0;
+    graph->bits = NULL;
+}
+
+static bool g_bitset_has(const struct graph* graph, vertex_t vi, vertex_t wj) {
+    return bitset_get(g_bits(graph, vi), wj);
+}
+
+static weight_t g_bitset_get(const struct graph* graph, vertex_t vi, vertex_t wj) {
+    return bitset_get(g_bits(graph, vi), wj) ? 1 : 0;
+}
+
+static void g_bitset_set(struct graph* graph, vertex_t vi, vertex_t wj, weight_t weight) {
+    (void) weight;
+
+    bitset_set(g_bits(graph, vi), wj);
+    bitset_set(g_bits(graph, wj), vi);
+}
+
+static void g_bitset_del(struct graph* graph, vertex_t vi, vertex_t wj) {
+    bitset_clear(g_bits(graph, vi), wj);
+    bitset_clear(g_bits(graph, wj), vi);
+}
+
+static size_t g_bitset_degree(const struct graph* graph, vertex_t vi) {
+    return row_popcount(g_bits(graph, vi), graph->words);
+}
+
+static bool g_bitset_neighbor_next(struct gneighbor_iterator* it, vertex_t* out_vertex, weight_t* out_weight) {
+    const uint64_t* row = g_bits(it->graph, it->vertex);
+    const uint64_t* mask = it->mask;
+
+    // look for the next set bit a word at once, where the
+    // masked vertices are discarded as (row AND NOT mask)
+    while (it->pos < it->end) {
+        size_t w = it->pos / BITSET_WORD_BITS;
+        uint64_t word = row[w] & (~(uint64_t) 0 << (it->pos % BITSET_WORD_BITS));
+        if (mask != NULL) {
+            word &= ~mask[w];
+        }
+
+        if (word == 0) {
+            it->pos = (w + 1) * BITSET_WORD_BITS;
             continue;
         }
 
-        visited[i] = true;
+        size_t pos = w * BITSET_WORD_BITS + __builtin_ctzll(word);
+        if (pos >= it->end) {
+            break;
+        }
 
-        // the actual path of vertex i
-        struct path* i_path = &minimal_paths[i];
+        *out_vertex = pos;
+        if (out_weight != NULL) {
+            *out_weight = 1;
+        }
 
-        // the vertices that have been accumulated
-        struct vertex_array* accumulated_vertices = &i_path->vertices;
-        // the weight accumulated of this path
-        int32_t accumulated_distance = i_path->weight;
+        it->pos = pos + 1;
+        return true;
+    }
 
-        for (vertex_t j = 0; j < vertex_len; j++) {
-            if (visited[j] || !graph_has(graph, i, j)) {
-                continue;
-            }
+    it->pos = it->end;
+    return false;
+}
 
-            // the weight of edge <i, j>
-            int32_t distance = graph_get(graph, i, j);
-            // the absorbed weight of edge <i, j> and
-            // the accumulated ones
-            int32_t absorbed_distance = distance + accumulated_distance;
+static bool g_triangle_reserve(struct graph* graph, size_t capacity) {
+    if (capacity <= graph->capacity && graph->triangle != NULL) {
+        return true;
+    }
+
+    weight_t empty_weight = g_empty_weight(graph);
 
-            struct path* j_path = &minimal_paths[j];
+    // the columns are packed one after another, so the new
+    // vertices just take the cells at the end
+    size_t cells = capacity * (capacity + 1) / 2;
+    size_t used_cells = graph->len * (graph->len + 1) / 2;
 
-            // if a path was found to have the lower weight
-            // then change it by this new path
+    weight_t* triangle = g_aligned_alloc(sizeof(weight_t) * cells);
+    if (triangle == NULL) {
+        return false;
+    }
 
-            if (j_path->weight > absorbed_distance) {
-                struct vertex_array* absorbed_vertices = &j_path->vertices;
+    if (used_cells > 0) {
+        memcpy(triangle, graph->triangle, sizeof(weight_t) * used_cells);
+    }
+    for (size_t k = used_cells; k < cells; k++) {
+        triangle[k] = empty_weight;
+    }
 
-                // clone the sequence model including this as
-                // the end vertex
-                vertex_array_clone(accumulated_vertices, absorbed_vertices);
-                vertex_array_reserve(absorbed_vertices, 1);
-                absorbed_vertices->data[absorbed_vertices->len++] = j;
+    free(graph->triangle);
+    graph->triangle = triangle;
+    graph->capacity = capacity;
 
-                // the new lower weight found
-                j_path->weight = absorbed_distance;
-            }
+    return true;
+}
 
-            queue_vertex_add(&queue, j);
+static void g_triangle_destroy(struct graph* graph) {
+    free(graph->triangle);
+    graph->triangle = NULL;
+}
+
+static bool g_triangle_has(const struct graph* graph, vertex_t vi, vertex_t wj) {
+    return *g_triangle(graph, vi, wj) != g_empty_weight(graph);
+}
+
+static weight_t g_triangle_get(const struct graph* graph, vertex_t vi, vertex_t wj) {
+    return *g_triangle(graph, vi, wj);
+}
+
+static void g_triangle_set(struct graph* graph, vertex_t vi, vertex_t wj, weight_t weight) {
+    // the edge is shared by both directions
+    *g_triangle(graph, vi, wj) = weight;
+}
+
+static void g_triangle_del(struct graph* graph, vertex_t vi, vertex_t wj) {
+    *g_triangle(graph, vi, wj) = g_empty_weight(graph);
+}
+
+static size_t g_triangle_degree(const struct graph* graph, vertex_t vi) {
+    weight_t empty_weight = g_empty_weight(graph);
+
+    // the cells <k, vi> for k <= vi
+    size_t count = row_count(g_triangle(graph, 0, vi), vi + 1, empty_weight);
+
+    // the cells <vi, j> for j > vi
+    if (vi + 1 < graph->len) {
+        size_t index = g_triangle(graph, vi, vi + 1) - graph->triangle;
+
+        for (vertex_t j = vi + 1; j < graph->len; index += j + 1, j++) {
+            if (graph->triangle[index] != empty_weight) {
+                count++;
+            }
         }
     }
 
-    // now add all generated paths in a map
-    hashmap_init(out_map, 0, u32path_destroyer);
+    return count;
+}
 
-    for (vertex_t i = 0; i < vertex_len; i++) {
-        struct path* path = &minimal_paths[i];
-        // if it couldn't generate a path
-        if (path->weight == INT32_MAX) {
-            continue;
+static bool g_triangle_neighbor_next(struct gneighbor_iterator* it, vertex_t* out_vertex, weight_t* out_weight) {
+    const struct graph* graph = it->graph;
+    const uint64_t* mask = it->mask;
+
+    weight_t empty_weight = g_empty_weight(graph);
+
+    vertex_t vi = it->vertex;
+    const weight_t* column = g_triangle(graph, 0, vi);
+
+    // the upper part of the column, it's contiguous
+    while (it->pos <= vi) {
+        size_t pos = row_find(column, it->pos, vi + 1, empty_weight);
+        if (pos > vi) {
+            it->pos = vi + 1;
+            break;
         }
-        // if the length is 1, it means that is the
-        // source vertex, so ignore it
-        if (path->vertices.len == 1) {
-            path_destroy(path);
+
+        it->pos = pos + 1;
+        if (mask != NULL && bitset_get(mask, pos)) {
             continue;
         }
 
-        // move path into heap to not loose it
-        struct path* heap_path = malloc(sizeof(struct path));
-        memcpy(heap_path, path, sizeof(struct path));
+        *out_vertex = pos;
+        if (out_weight != NULL) {
+            *out_weight = column[pos];
+        }
+
+        return true;
+    }
+
+    // the lower part, the cell <vi, j> is in the column j and
+    // the next one is j + 1 cells ahead
+    if (it->pos < it->end) {
+        size_t index = g_triangle(graph, vi, it->pos) - graph->triangle;
+
+        for (; it->pos < it->end; index += it->pos + 1, it->pos++) {
+            weight_t weight = graph->triangle[index];
+            if (weight == empty_weight || (mask != NULL && bitset_get(mask, it->pos))) {
+                continue;
+            }
+
+            *out_vertex = it->pos;
+            if (out_weight != NULL) {
+                *out_weight = weight;
+            }
 
-        hashmap_put(out_map, i, heap_path);
+            it->pos++;
+            return true;
+        }
     }
 
-    free(visited);
-    free(minimal_paths);
+    return false;
 }
 
-void gcomponent_destroy(struct gcomponent* comp) {
-    if (comp == NULL) {
+static bool g_indexed_reserve(struct graph* graph, size_t capacity) {
+    if (capacity <= graph->capacity && graph->matrix != NULL) {
+        return true;
+    }
+
+    size_t len = graph->len;
+    size_t old_stride = graph->stride;
+
+    struct vertex_array* lists = realloc(graph->lists, sizeof(struct vertex_array) * (capacity + 1));
+    if (lists == NULL) {
+        return false;
+    }
+
+    memset(&lists[len], 0, sizeof(struct vertex_array) * (capacity + 1 - len));
+    graph->lists = lists;
+
+    if (!g_matrix_reserve(graph, capacity)) {
+        return false;
+    }
+
+    // the positions follow the same rows as the matrix, but
+    // just the ones of the edges are meaningful
+    vertex_t* positions = malloc(sizeof(vertex_t) * (graph->stride * capacity + 1));
+    if (positions == NULL) {
+        return false;
+    }
+
+    for (vertex_t i = 0; i < len; i++) {
+        memcpy(&positions[i * graph->stride], &graph->positions[i * old_stride], sizeof(vertex_t) * len);
+    }
+
+    free(graph->positions);
+    graph->positions = positions;
+
+    return true;
+}
+
+static void g_indexed_destroy(struct graph* graph) {
+    if (graph->lists != NULL) {
+        for (size_t i = 0; i < graph->capacity; i++) {
+            vertex_array_destroy(&graph->lists[i]);
+        }
+    }
+
+    free(graph->lists);
+    free(graph->positions);
+
+    graph->lists = NULL;
+    graph->positions = NULL;
+
+    g_matrix_destroy(graph);
+}
+
+static void g_indexed_set(struct graph* graph, vertex_t vi, vertex_t wj, weight_t weight) {
+    // just a new edge changes the neighbors, otherwise it's
+    // the weight what changes
+    if (!g_matrix_has(graph, vi, wj)) {
+        g_indexed_push(graph, vi, wj);
+        if (vi != wj) {
+            g_indexed_push(graph, wj, vi);
+        }
+    }
+
+    g_matrix_set(graph, vi, wj, weight);
+}
+
+static void g_indexed_del(struct graph* graph, vertex_t vi, vertex_t wj) {
+    if (!g_matrix_has(graph, vi, wj)) {
         return;
     }
 
-    free(comp->array.data);
-    comp->array.len = 0;
-    comp->array.data = NULL;
+    g_indexed_swap_remove(graph, vi, wj);
+    if (vi != wj) {
+        g_indexed_swap_remove(graph, wj, vi);
+    }
 
-    hashmap_destroy(&comp->map);
+    g_matrix_del(graph, vi, wj);
 }
 
-static inline int32_t g_empty_weight(const struct graph* graph) {
-    if (graph == NULL) {
-        return 0;
+static size_t g_indexed_degree(const struct graph* graph, vertex_t vi) {
+    return graph->lists[vi].len;
+}
+
+static void g_indexed_neighbor_init(struct gneighbor_iterator* it) {
+    it->pos = 0;
+    it->end = it->graph->lists[it->vertex].len;
+}
+
+static bool g_indexed_neighbor_next(struct gneighbor_iterator* it, vertex_t* out_vertex, weight_t* out_weight) {
+    const struct graph* graph = it->graph;
+    const vertex_t* neighbors = graph->lists[it->vertex].data;
+    const uint64_t* mask = it->mask;
+
+    for (; it->pos < it->end; it->pos++) {
+        vertex_t j = neighbors[it->pos];
+        if (mask != NULL && bitset_get(mask, j)) {
+            continue;
+        }
+
+        *out_vertex = j;
+        if (out_weight != NULL) {
+            *out_weight = g_row(graph, it->vertex)[j];
+        }
+
+        it->pos++;
+        return true;
+    }
+
+    return false;
+}
+
+static void g_indexed_push(struct graph* graph, vertex_t vi, vertex_t wj) {
+    struct vertex_array* list = &graph->lists[vi];
+
+    // grow geometrically, vertex_array_reserve grows just by
+    // the given capacity
+    if (list->len >= list->capacity) {
+        vertex_array_reserve(list, list->capacity > 0 ? list->capacity : 4);
     }
 
-    return graph->weighted ? NONE_WEIGHT32_VALUE : 0;
+    graph->positions[vi * graph->stride + wj] = list->len;
+    list->data[list->len++] = wj;
 }
 
-static inline bool g_is_out(const struct graph* graph, size_t vi, size_t wj) {
-    return graph == NULL || vi >= graph->len || wj >= graph->len;
+static void g_indexed_swap_remove(struct graph* graph, vertex_t vi, vertex_t wj) {
+    struct vertex_array* list = &graph->lists[vi];
+    vertex_t* positions = &graph->positions[vi * graph->stride];
+
+    vertex_t pos = positions[wj];
+    vertex_t last = list->data[--list->len];
+
+    list->data[pos] = last;
+    positions[last] = pos;
 }
 
 static bool g_initial_path(struct graph* graph, vertex_t start_vertex, vertex_t end_vertex) {
@@ -613,11 +2599,209 @@ static bool g_initial_path(struct graph* graph, vertex_t start_vertex, vertex_t
     return graph_reachable(graph, start_vertex, end_vertex);
 }
 
+static void g_unlink(struct graph* graph, vertex_t vi, vertex_t wj) {
+    graph->ops->del(graph, vi, wj);
+
+    graph->edge_len--;
+    gdegree_dec(&graph->degree, vi);
+    if (vi != wj) {
+        gdegree_dec(&graph->degree, wj);
+    }
+}
+
+static void g_init_degrees(struct graph* graph) {
+    size_t len = graph->len;
+    size_t* degrees = malloc(sizeof(size_t) * (len + 1));
+
+    // every edge is counted by both vertices, except a loop
+    size_t endpoints = 0;
+    for (vertex_t i = 0; i < len; i++) {
+        size_t degree = graph->ops->degree(graph, i);
+        endpoints += degree;
+
+        if (degrees != NULL) {
+            degrees[i] = degree;
+        }
+        if (graph->ops->has(graph, i, i)) {
+            endpoints++;
+        }
+    }
+
+    graph->edge_len = endpoints / 2;
+    gdegree_init(&graph->degree, len, degrees);
+
+    // without room for the degrees the buckets start empty, and
+    // every vertex is raised up to its degree one at a time
+    for (vertex_t i = 0; degrees == NULL && graph->degree.len == len && i < len; i++) {
+        for (size_t d = graph->ops->degree(graph, i); d > 0; d--) {
+            gdegree_inc(&graph->degree, i);
+        }
+    }
+
+    free(degrees);
+
+    // the layout can't be used without its degrees, the graph
+    // is left empty such as when reserve fails
+    if (graph->degree.len != len) {
+        bool weighted = graph->weighted;
+        const struct graph_ops* ops = graph->ops;
+
+        graph_destroy(graph);
+        graph->weighted = weighted;
+        graph->ops = ops;
+    }
+}
+
+static void g_cache_add_vertex(struct graph* graph, vertex_t vi) {
+    struct gcomponent* comp = graph->cache.component;
+    if (comp == NULL) {
+        return;
+    }
+
+    uint32_t* data = realloc(comp->array.data, sizeof(uint32_t) * graph->capacity);
+    if (data == NULL) {
+        g_invalidate_cache(graph);
+        return;
+    }
+
+    // the vertex is alone in its own connected component, its
+    // ID is given by the lowest (and unique) vertex
+    uint32_t class_id = vi + 1;
+    data[vi] = class_id;
+
+    comp->array.data = data;
+    comp->array.len = graph->len;
+
+    struct vertex_array* arr = calloc(1, sizeof(struct vertex_array));
+    vertex_array_from(arr, (vertex_t[1]){vi}, 1);
+    hashmap_put(&comp->map, class_id, arr);
+}
+
+static void g_cache_remove_vertex(struct graph* graph, vertex_t vi) {
+    struct gcomponent* comp = graph->cache.component;
+    if (comp == NULL) {
+        return;
+    }
+
+    uint32_t* classes = comp->array.data;
+    struct vertex_array* members = hashmap_del(&comp->map, classes[vi]);
+    if (members == NULL) {
+        g_invalidate_cache(graph);
+        return;
+    }
+
+    // the remaining members can be split in several connected
+    // components, so they're labeled again from scratch
+    for (size_t k = 0; k < members->len; k++) {
+        classes[members->data[k]] = 0;
+    }
+
+    vertex_t* queue = malloc(sizeof(vertex_t) * (members->len + 1));
+
+    // the members are sorted, so the first one that is found
+    // without a connected component is the lowest one of it
+    for (size_t k = 0; k < members->len; k++) {
+        vertex_t i = members->data[k];
+        if (i == vi || classes[i] != 0) {
+            continue;
+        }
+
+        uint32_t class_id = i + 1;
+        classes[i] = class_id;
+
+        size_t queue_head = 0;
+        size_t queue_tail = 0;
+        queue[queue_tail++] = i;
+
+        while (queue_head < queue_tail) {
+            vertex_t v = queue[queue_head++];
+
+            struct gneighbor_iterator it = {0};
+            graph_neighbors(graph, v, &it);
+
+            for (vertex_t j = 0; gneighbor_next(&it, &j, NULL);) {
+                if (classes[j] != 0) {
+                    continue;
+                }
+
+                classes[j] = class_id;
+                queue[queue_tail++] = j;
+            }
+        }
+    }
+
+    // add the members in the same order such as
+    // graph_components does, to keep the sequences sorted
+    for (size_t k = 0; k < members->len; k++) {
+        vertex_t i = members->data[k];
+        if (i == vi) {
+            continue;
+        }
+
+        struct vertex_array* arr = hashmap_get(&comp->map, classes[i]);
+        if (arr == NULL) {
+            arr = calloc(1, sizeof(struct vertex_array));
+            hashmap_put(&comp->map, classes[i], arr);
+        }
+
+        vertex_array_reserve(arr, 1);
+        arr->data[arr->len++] = i;
+    }
+
+    free(queue);
+    u32vertices_destroyer(members);
+}
+
+static void g_cache_remap(struct gcomponent* comp, const vertex_t* map, size_t len) {
+    uint32_t* classes = calloc(len + 1, sizeof(uint32_t));
+
+    u32vertices_map old_map = comp->map;
+    memset(&comp->map, 0, sizeof(u32vertices_map));
+    hashmap_init(&comp->map, hashmap_size(&old_map), u32vertices_destroyer);
+
+    struct hashmap_iterator it = {0};
+    hashmap_iterator_init(&it, &old_map);
+
+    for (struct map_entry entry; hashmap_iterator_next(&it, &entry);) {
+        struct vertex_array* arr = entry.value;
+
+        // the order is kept, so the lowest vertex still gives
+        // the connected component's ID
+        for (size_t k = 0; k < arr->len; k++) {
+            arr->data[k] = map[arr->data[k]];
+        }
+
+        uint32_t class_id = arr->data[0] + 1;
+        for (size_t k = 0; k < arr->len; k++) {
+            classes[arr->data[k]] = class_id;
+        }
+
+        hashmap_put(&comp->map, class_id, arr);
+    }
+
+    // the arrays were moved to the new map
+    old_map.destroyer = NULL;
+    hashmap_destroy(&old_map);
+
+    free(comp->array.data);
+    comp->array.len = len;
+    comp->array.data = classes;
+}
+
+static void g_invalidate_landmarks(struct graph* graph) {
+    struct glandmarks* landmarks = graph->cache.landmarks;
+    glandmarks_destroy(landmarks);
+    free(landmarks);
+
+    graph->cache.landmarks = NULL;
+}
+
 static void g_invalidate_cache(struct graph* graph) {
     struct gcomponent* component = graph->cache.component;
     gcomponent_destroy(component);
     free(component);
 
     graph->cache.component = NULL;
+    g_invalidate_landmarks(graph);
 }
 
@@ -0,0 +1,295 @@
+#include <stdlib.h>
+
+#include <heap.h>
+
+/**
+ * Move a vertex into a position of the heap.
+ *
+ * @param heap the heap where the vertex is
+ * @param pos the position where to move it
+ * @param vertex the vertex to move
+ * @param key the key of the vertex
+ */
+static inline void _heap_place(struct heap_vertex* heap, size_t pos, vertex_t vertex, distance_t key) {
+    heap->data[pos] = vertex;
+    heap->keys[pos] = key;
+    heap->positions[vertex] = pos;
+}
+
+/**
+ * Move up a vertex until its parent has a lower or equal key.
+ *
+ * @param heap the heap where the vertex is
+ * @param pos the position of the vertex
+ */
+static void _heap_sift_up(struct heap_vertex* heap, size_t pos) {
+    vertex_t vertex = heap->data[pos];
+    distance_t key = heap->keys[pos];
+
+    // the parents are moved down instead of swapping them, so
+    // the vertex is written once
+    while (pos > 0) {
+        size_t parent = (pos - 1) / HEAP_ARITY;
+        if (heap->keys[parent] <= key) {
+            break;
+        }
+
+        _heap_place(heap, pos, heap->data[parent], heap->keys[parent]);
+        pos = parent;
+    }
+
+    _heap_place(heap, pos, vertex, key);
+}
+
+/**
+ * Move down a vertex until its children have greater or equal
+ * keys.
+ *
+ * @param heap the heap where the vertex is
+ * @param pos the position of the vertex
+ */
+static void _heap_sift_down(struct heap_vertex* heap, size_t pos) {
+    vertex_t vertex = heap->data[pos];
+    distance_t key = heap->keys[pos];
+
+    for (;;) {
+        size_t first = pos * HEAP_ARITY + 1;
+        if (first >= heap->size) {
+            break;
+        }
+
+        size_t last = first + HEAP_ARITY < heap->size ? first + HEAP_ARITY : heap->size;
+        size_t least = first;
+
+        for (size_t child = first + 1; child < last; child++) {
+            if (heap->keys[child] < heap->keys[least]) {
+                least = child;
+            }
+        }
+
+        if (heap->keys[least] >= key) {
+            break;
+        }
+
+        _heap_place(heap, pos, heap->data[least], heap->keys[least]);
+        pos = least;
+    }
+
+    _heap_place(heap, pos, vertex, key);
+}
+
+/**
+ * Return the bucket of a key.
+ *
+ * @param heap the queue
+ * @param key the key
+ * @return the position of the bucket in heads
+ */
+static inline size_t _heap_dial_bucket(const struct heap_dial* heap, distance_t key) {
+    return (size_t) key % heap->span;
+}
+
+/**
+ * Remove a queued vertex from its bucket.
+ *
+ * @param heap the queue where the vertex is
+ * @param vertex the vertex to remove
+ */
+static void _heap_dial_unlink(struct heap_dial* heap, vertex_t vertex) {
+    vertex_t prev = heap->prev[vertex];
+    vertex_t next = heap->next[vertex];
+
+    if (prev == VERTEX_T_MAX) {
+        heap->heads[_heap_dial_bucket(heap, heap->keys[vertex])] = next;
+    } else {
+        heap->next[prev] = next;
+    }
+
+    if (next != VERTEX_T_MAX) {
+        heap->prev[next] = prev;
+    }
+}
+
+bool heap_vertex_init(struct heap_vertex* heap, size_t len) {
+    if (heap == NULL) {
+        return false;
+    }
+
+    heap->len = len;
+    heap->size = 0;
+    heap->data = malloc(sizeof(vertex_t) * (len + 1));
+    heap->keys = malloc(sizeof(distance_t) * (len + 1));
+    heap->positions = malloc(sizeof(size_t) * (len + 1));
+
+    if (heap->data == NULL || heap->keys == NULL || heap->positions == NULL) {
+        heap_vertex_destroy(heap);
+        return false;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        heap->positions[i] = SIZE_MAX;
+    }
+
+    return true;
+}
+
+void heap_vertex_destroy(struct heap_vertex* heap) {
+    if (heap == NULL) {
+        return;
+    }
+
+    free(heap->data);
+    free(heap->keys);
+    free(heap->positions);
+
+    heap->len = 0;
+    heap->size = 0;
+    heap->data = NULL;
+    heap->keys = NULL;
+    heap->positions = NULL;
+}
+
+bool heap_vertex_push(struct heap_vertex* heap, vertex_t vertex, distance_t key) {
+    if (heap == NULL || vertex >= heap->len) {
+        return false;
+    }
+
+    size_t pos = heap->positions[vertex];
+
+    if (pos == SIZE_MAX) {
+        pos = heap->size++;
+    } else if (heap->keys[pos] <= key) {
+        return false;
+    }
+
+    // a lower key can just move the vertex up
+    _heap_place(heap, pos, vertex, key);
+    _heap_sift_up(heap, pos);
+
+    return true;
+}
+
+vertex_t heap_vertex_pop(struct heap_vertex* heap, distance_t* out_key) {
+    if (heap == NULL || heap->size == 0) {
+        return VERTEX_T_MAX;
+    }
+
+    vertex_t vertex = heap->data[0];
+    if (out_key != NULL) {
+        *out_key = heap->keys[0];
+    }
+
+    heap->positions[vertex] = SIZE_MAX;
+    heap->size--;
+
+    // the last vertex fills the hole at the root
+    if (heap->size > 0) {
+        _heap_place(heap, 0, heap->data[heap->size], heap->keys[heap->size]);
+        _heap_sift_down(heap, 0);
+    }
+
+    return vertex;
+}
+
+bool heap_dial_init(struct heap_dial* heap, size_t len, size_t max_step) {
+    if (heap == NULL) {
+        return false;
+    }
+
+    heap->len = len;
+    heap->size = 0;
+    heap->span = max_step + 1;
+    heap->cursor = 0;
+    heap->heads = malloc(sizeof(vertex_t) * heap->span);
+    heap->next = malloc(sizeof(vertex_t) * (len + 1));
+    heap->prev = malloc(sizeof(vertex_t) * (len + 1));
+    heap->keys = malloc(sizeof(distance_t) * (len + 1));
+
+    if (heap->heads == NULL || heap->next == NULL || heap->prev == NULL || heap->keys == NULL) {
+        heap_dial_destroy(heap);
+        return false;
+    }
+
+    for (size_t k = 0; k < heap->span; k++) {
+        heap->heads[k] = VERTEX_T_MAX;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        heap->keys[i] = DISTANCE_MAX;
+    }
+
+    return true;
+}
+
+void heap_dial_destroy(struct heap_dial* heap) {
+    if (heap == NULL) {
+        return;
+    }
+
+    free(heap->heads);
+    free(heap->next);
+    free(heap->prev);
+    free(heap->keys);
+
+    heap->len = 0;
+    heap->size = 0;
+    heap->span = 0;
+    heap->cursor = 0;
+    heap->heads = NULL;
+    heap->next = NULL;
+    heap->prev = NULL;
+    heap->keys = NULL;
+}
+
+bool heap_dial_push(struct heap_dial* heap, vertex_t vertex, distance_t key) {
+    if (heap == NULL || vertex >= heap->len) {
+        return false;
+    }
+
+    if (heap->keys[vertex] != DISTANCE_MAX) {
+        if (heap->keys[vertex] <= key) {
+            return false;
+        }
+
+        _heap_dial_unlink(heap, vertex);
+    } else {
+        heap->size++;
+    }
+
+    size_t bucket = _heap_dial_bucket(heap, key);
+    vertex_t head = heap->heads[bucket];
+
+    heap->keys[vertex] = key;
+    heap->prev[vertex] = VERTEX_T_MAX;
+    heap->next[vertex] = head;
+    if (head != VERTEX_T_MAX) {
+        heap->prev[head] = vertex;
+    }
+    heap->heads[bucket] = vertex;
+
+    return true;
+}
+
+vertex_t heap_dial_pop(struct heap_dial* heap, distance_t* out_key) {
+    if (heap == NULL || heap->size == 0) {
+        return VERTEX_T_MAX;
+    }
+
+    // the keys are in [cursor, cursor + span), so a bucket
+    // holds a single key and the first one that isn't empty
+    // has the minimal
+    while (heap->heads[_heap_dial_bucket(heap, heap->cursor)] == VERTEX_T_MAX) {
+        heap->cursor++;
+    }
+
+    vertex_t vertex = heap->heads[_heap_dial_bucket(heap, heap->cursor)];
+    if (out_key != NULL) {
+        *out_key = heap->keys[vertex];
+    }
+
+    _heap_dial_unlink(heap, vertex);
+    heap->keys[vertex] = DISTANCE_MAX;
+    heap->size--;
+
+    return vertex;
+}
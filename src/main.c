@@ -1,6 +1,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <graph.h>
 
@@ -9,8 +10,21 @@
  *
  * @param graph the graph to store the data
  * @param file the file to read
+ * @param storage the layout to store the edges, if it is
+ *                GRAPH_STORAGE_AUTO then it's picked from the
+ *                density of the graph
+ * @return true if the data is valid, otherwise false
  */
-static void fread_graph(struct graph* graph, FILE* file);
+static bool fread_graph(struct graph* graph, FILE* file, enum graph_storage storage);
+/**
+ * Parse the name of a storage layout.
+ *
+ * @param name the name (matrix, csr, bitset, triangle, indexed
+ *             or auto)
+ * @param out_storage where it'll store the parsed layout
+ * @return true if the name is known, otherwise false
+ */
+static bool parse_storage(const char* name, enum graph_storage* out_storage);
 /**
  * The main menu.
  *
@@ -20,6 +34,14 @@ static void on_menu(struct graph* graph);
 
 int main(int argc, char** args) {
     const char* filename = argc > 1 ? args[1] : "Panas.in";
+
+    // the storage can be forced, e.g. to benchmark them
+    enum graph_storage storage = GRAPH_STORAGE_AUTO;
+    if (argc > 2 && !parse_storage(args[2], &storage)) {
+        printf("The storage %s is unknown (matrix, csr, bitset, triangle, indexed or auto)\n", args[2]);
+        return 1;
+    }
+
     FILE* file = fopen(filename, "r");
     if (file == NULL) {
         printf("The file %s doesn't exist or cannot be read\n", filename);
@@ -29,9 +51,14 @@ int main(int argc, char** args) {
     struct graph graph = {0};
 
     printf("Loading file: %s\n", filename);
-    fread_graph(&graph, file);
+    bool loaded = fread_graph(&graph, file, storage);
     fclose(file);
 
+    if (!loaded) {
+        graph_destroy(&graph);
+        return 1;
+    }
+
     on_menu(&graph);
 
     graph_destroy(&graph);
@@ -39,25 +66,69 @@ int main(int argc, char** args) {
     return 0;
 }
 
-static void fread_graph(struct graph* graph, FILE* file) {
+static bool fread_graph(struct graph* graph, FILE* file, enum graph_storage storage) {
     if (graph == NULL || file == NULL) {
-        return;
+        return false;
     }
 
     size_t vertex_len = 0;
     size_t edge_len = 0; 
     fscanf(file, "%ld %ld", &vertex_len, &edge_len);
 
-    graph_init(graph, true, vertex_len);
+    // the edges are read at once to build the storage from
+    // them instead of adding them one by one
+    struct edge* edges = malloc(sizeof(struct edge) * (edge_len + 1));
+    if (edges == NULL) {
+        return false;
+    }
 
     for (size_t i = 0; i < edge_len; i++) {
         vertex_t vi = 0;
         vertex_t wj = 0;
-        int32_t weight = 0;
-        fscanf(file, "%lu %lu %d", &vi, &wj, &weight);
+        // it's read in the widest type and then narrowed to
+        // the type of weights
+        double weight = 0;
+        fscanf(file, "%" VERTEX_PRI " %" VERTEX_PRI " %lf", &vi, &wj, &weight);
+
+        // a weight that the type can't hold would be narrowed
+        // into another one or into the sentinel of no edge
+        if (!(weight >= 0 && weight < (double) NONE_WEIGHT_VALUE)) {
+            printf("The weight %g of the edge %" VERTEX_PRI "-%" VERTEX_PRI " is out of range [0, %g)\n",
+                   weight, vi, wj, (double) NONE_WEIGHT_VALUE);
+            free(edges);
+            return false;
+        }
 
-        graph_addw(graph, vi - 1, wj - 1, weight);
+        edges[i] = (struct edge) {vi - 1, wj - 1, (weight_t) weight};
     }
+
+    graph_init_edges(graph, true, vertex_len, storage, edges, edge_len);
+
+    free(edges);
+    return true;
+}
+
+static bool parse_storage(const char* name, enum graph_storage* out_storage) {
+    static const struct {
+        const char* name;
+        enum graph_storage storage;
+    } storages[] = {
+        {"matrix", GRAPH_STORAGE_MATRIX},
+        {"csr", GRAPH_STORAGE_CSR},
+        {"bitset", GRAPH_STORAGE_BITSET},
+        {"triangle", GRAPH_STORAGE_TRIANGLE},
+        {"indexed", GRAPH_STORAGE_INDEXED},
+        {"auto", GRAPH_STORAGE_AUTO},
+    };
+
+    for (size_t k = 0; k < sizeof(storages) / sizeof(storages[0]); k++) {
+        if (strcmp(name, storages[k].name) == 0) {
+            *out_storage = storages[k].storage;
+            return true;
+        }
+    }
+
+    return false;
 }
 
 static void on_menu(struct graph* graph) {
@@ -99,7 +170,7 @@ static void on_menu(struct graph* graph) {
                     struct vertex_array* arr = entry.value;
 
                     for (size_t j = 0; j < arr->len; j++) {
-                        printf(" %lu", arr->data[j] + 1);
+                        printf(" %" VERTEX_PRI, arr->data[j] + 1);
                     }
 
                     printf("\n");
@@ -112,13 +183,13 @@ static void on_menu(struct graph* graph) {
                 vertex_t w = 0;
 
                 printf("Input 1st vertex: ");
-                scanf("%lu", &v);
+                scanf("%" VERTEX_PRI, &v);
                 
                 printf("Input 2nd vertex: ");
-                scanf("%lu", &w);
+                scanf("%" VERTEX_PRI, &w);
 
                 bool reachable = graph_reachable(graph, v - 1, w - 1);
-                printf("Is v%lu~v%lu: %s\n", v, w, reachable ? "Yes" : "No");
+                printf("Is v%" VERTEX_PRI "~v%" VERTEX_PRI ": %s\n", v, w, reachable ? "Yes" : "No");
                 break;
             }
             case 4: {
@@ -126,10 +197,10 @@ static void on_menu(struct graph* graph) {
                 vertex_t w = 0;
 
                 printf("Input 1st vertex: ");
-                scanf("%lu", &v);
+                scanf("%" VERTEX_PRI, &v);
                 
                 printf("Input 2nd vertex: ");
-                scanf("%lu", &w);
+                scanf("%" VERTEX_PRI, &w);
 
                 u32vertices_map short_paths = {0};
                 graph_short_path(graph, v - 1, w - 1, &short_paths);
@@ -143,7 +214,7 @@ static void on_menu(struct graph* graph) {
 
                     printf("  (%lu) ", it.found_size);
                     for (size_t i = 0; i < vertices->len; i++) {
-                        printf("%lu", vertices->data[i] + 1);
+                        printf("%" VERTEX_PRI, vertices->data[i] + 1);
 
                         if (i + 1 != vertices->len) {
                             printf("-");
@@ -161,7 +232,7 @@ static void on_menu(struct graph* graph) {
                 printf("Input the vertex: ");
 
                 vertex_t v = 0;
-                scanf("%lu", &v);
+                scanf("%" VERTEX_PRI, &v);
 
                 if (v - 1 >= graph->len) {
                     break;
@@ -215,19 +286,19 @@ static void on_menu(struct graph* graph) {
                 vertex_t w = 0;
 
                 printf("Input 1st vertex: ");
-                scanf("%lu", &v);
+                scanf("%" VERTEX_PRI, &v);
                 
                 printf("Input 2nd vertex: ");
-                scanf("%lu", &w);
+                scanf("%" VERTEX_PRI, &w);
 
                 u32path_map minimal_paths = {0};
-                graph_minimal_path(graph, v - 1, w - 1, &minimal_paths);
+                graph_minimal_path_mode(graph, v - 1, w - 1, GRAPH_PATH_BIDIRECTIONAL, &minimal_paths);
 
                 struct path* path = hashmap_get(&minimal_paths, w - 1);
                 if (path != NULL) {
                     printf(" ");
                     vertex_array_print(&path->vertices);
-                    printf(": %d\n", path->weight);
+                    printf(": %" DISTANCE_PRI "\n", path->weight);
                 }
 
                 hashmap_destroy(&minimal_paths);
@@ -237,7 +308,7 @@ static void on_menu(struct graph* graph) {
                 vertex_t v = 0;
 
                 printf("Input the vertex: ");
-                scanf("%lu", &v);
+                scanf("%" VERTEX_PRI, &v);
                 printf("\n");
 
                 u32path_map minimal_paths = {0};
@@ -249,9 +320,9 @@ static void on_menu(struct graph* graph) {
                     struct path* path = entry.value;
                     struct vertex_array* vertices = &path->vertices;
 
-                    printf(" %2lu al %2lu:  ", vertices->data[0] + 1, vertices->data[vertices->len - 1] + 1);
+                    printf(" %2" VERTEX_PRI " al %2" VERTEX_PRI ":  ", vertices->data[0] + 1, vertices->data[vertices->len - 1] + 1);
                     vertex_array_print(vertices);
-                    printf(": %d\n", path->weight);
+                    printf(": %" DISTANCE_PRI "\n", path->weight);
                 }
 
                 hashmap_destroy(&minimal_paths);
@@ -95,25 +95,20 @@ void hashmap_reserve(struct hashmap* map, msize_t capacity) {
     map->bucks = new_bucks;
     map->size = 0;
 
-    // rehash all nodes in the new buck array
-
+    // rehash all nodes in the new buck array, every node is
+    // unlinked from its old chain before moving it
     for (size_t i = 0; i < old_reserved && size > 0; i++) {
         struct hashmap_node* node = old_bucks[i];
-        if (node == NULL) {
-            continue;
-        }
 
-        size--;
+        while (node != NULL) {
+            struct hashmap_node* next_node = node->next;
+            node->next = NULL;
 
-        struct hashmap_node* previous_node = node;
-        struct hashmap_node* actual_node = node->next;
+            _hashmap_put(map, node, NULL, false);
+            size--;
 
-        for (; actual_node != NULL; actual_node = actual_node->next) {
-            _hashmap_put(map, previous_node, NULL, false);
-            previous_node = node;
+            node = next_node;
         }
-
-        _hashmap_put(map, previous_node, NULL, false);
     }
     
     free(old_bucks);
@@ -126,28 +121,18 @@ void hashmap_destroy(struct hashmap* map) {
 
     for (size_t i = 0; i < map->reserved && map->size > 0; i++) {
         struct hashmap_node* node = map->bucks[i];
-        if (node == NULL) {
-            continue;
-        }
-
-        map->size--;
 
-        struct hashmap_node* previous_node = node;
-        struct hashmap_node* actual_node = node->next;
+        while (node != NULL) {
+            struct hashmap_node* next_node = node->next;
 
-        for (; actual_node != NULL; actual_node = actual_node->next) {
             if (map->destroyer != NULL) {
-                map->destroyer(previous_node->entry.value);
+                map->destroyer(node->entry.value);
             }
-            free(previous_node);
-
-            previous_node = actual_node;
-        }
+            free(node);
+            map->size--;
 
-        if (map->destroyer != NULL) {
-            map->destroyer(previous_node->entry.value);
+            node = next_node;
         }
-        free(previous_node);
     }
 
     map->reserved = 0;
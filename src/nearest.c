@@ -0,0 +1,429 @@
+#include <stdlib.h>
+
+#include <graph.h>
+#include <bitset.h>
+
+/**
+ * Represents the first capacity of the table, the queue and the
+ * found vertices, they grow geometrically with the search.
+ */
+#define GNEAREST_INITIAL_CAPACITY 64
+
+/**
+ * Represents a touched vertex of the search.
+ *
+ * @member vertex the vertex, VERTEX_T_MAX if the slot is free
+ * @member distance the weight of the weakest path found to it
+ * @member settled if the distance is final
+ */
+struct gnearest_slot {
+    vertex_t vertex;
+    distance_t distance;
+    bool settled;
+};
+
+/**
+ * Represents a queued vertex, a vertex can be queued several
+ * times and just the entry with its actual distance counts.
+ *
+ * @member vertex the queued vertex
+ * @member distance the distance when it was queued
+ */
+struct gnearest_entry {
+    vertex_t vertex;
+    distance_t distance;
+};
+
+/**
+ * Represents the state of a search, everything is sized by the
+ * touched vertices instead of the graph.
+ *
+ * @member slots an open-addressing table of the touched vertices
+ * @member capacity the length of slots, a power of two
+ * @member size the length of used slots
+ * @member queue a binary min-heap by distance
+ * @member queue_len the length of queued entries
+ * @member queue_capacity the length of entries that it can hold
+ */
+struct gnearest_search {
+    struct gnearest_slot* slots;
+    size_t capacity;
+    size_t size;
+
+    struct gnearest_entry* queue;
+    size_t queue_len;
+    size_t queue_capacity;
+};
+
+/**
+ * Run Dijkstra from a vertex on the touched vertices, until it
+ * finds k vertices or every vertex up to a distance.
+ *
+ * @param graph the graph to search
+ * @param vi the source vertex, it's not added
+ * @param k the length of vertices to find
+ * @param max_distance the greatest distance to find
+ * @param out where it'll add the vertices by ascending distance
+ * @return true if it could search, otherwise false
+ */
+static bool _gnearest_dijkstra(struct graph* graph,
+                               vertex_t vi,
+                               size_t k,
+                               distance_t max_distance,
+                               struct gnearest_array* out);
+/**
+ * Check if a vertex is not in a graph.
+ *
+ * @param graph the graph
+ * @param vi the vertex
+ * @return true if it's out or it was removed, otherwise false
+ */
+static bool _gnearest_is_out(const struct graph* graph, vertex_t vi);
+/**
+ * Add a vertex at the end of an array, it grows geometrically.
+ *
+ * @param array the array where to add the vertex
+ * @param vertex the vertex to add
+ * @param distance the distance of the vertex
+ * @return true if it could add it, otherwise false
+ */
+static bool _gnearest_append(struct gnearest_array* array, vertex_t vertex, distance_t distance);
+/**
+ * Return the slot of a vertex, it's taken if the vertex wasn't
+ * touched.
+ *
+ * @param search the state of the search
+ * @param vertex the vertex to look for
+ * @return the slot, NULL if the table couldn't grow
+ */
+static struct gnearest_slot* _gnearest_slot(struct gnearest_search* search, vertex_t vertex);
+/**
+ * Double the table of touched vertices.
+ *
+ * @param search the state of the search
+ * @return true if it could grow, otherwise false
+ */
+static bool _gnearest_grow(struct gnearest_search* search);
+/**
+ * Add a vertex into the queue.
+ *
+ * @param search the state of the search
+ * @param vertex the vertex to add
+ * @param distance the distance of the vertex
+ * @return true if it could add it, otherwise false
+ */
+static bool _gnearest_push(struct gnearest_search* search, vertex_t vertex, distance_t distance);
+/**
+ * Extract the entry with the minimal distance from the queue.
+ *
+ * @param search the state of the search, the queue must not be
+ *               empty
+ * @return the entry
+ */
+static struct gnearest_entry _gnearest_pop(struct gnearest_search* search);
+
+size_t graph_nearest_k(struct graph* graph, vertex_t vi, size_t k, struct gnearest* out) {
+    if (out == NULL || k == 0) {
+        return 0;
+    }
+
+    // the search never finds more than k vertices, so it
+    // doesn't grow the caller's array
+    struct gnearest_array found = {.capacity = k, .len = 0, .data = out};
+
+    return _gnearest_dijkstra(graph, vi, k, DISTANCE_MAX, &found) ? found.len : 0;
+}
+
+bool graph_minimal_path_bounded(struct graph* graph,
+                                vertex_t start_vertex,
+                                distance_t max_distance,
+                                struct gnearest_array* out_array) {
+    if (out_array == NULL) {
+        return false;
+    }
+
+    *out_array = (struct gnearest_array) {0};
+
+    if (!_gnearest_dijkstra(graph, start_vertex, SIZE_MAX, max_distance, out_array)) {
+        gnearest_array_destroy(out_array);
+        return false;
+    }
+
+    return true;
+}
+
+bool graph_wave_bounded(const struct graph* graph,
+                        vertex_t start_vertex,
+                        size_t max_depth,
+                        struct gnearest_array* out_array) {
+    if (out_array == NULL) {
+        return false;
+    }
+
+    *out_array = (struct gnearest_array) {0};
+    if (_gnearest_is_out(graph, start_vertex)) {
+        return false;
+    }
+
+    struct gnearest_search search = {0};
+
+    struct gnearest_slot* start = _gnearest_slot(&search, start_vertex);
+    bool ready = start != NULL;
+    if (ready) {
+        start->settled = true;
+    }
+
+    // the found vertices are the queue of the breadth-first
+    // search, they're appended by layer
+    vertex_t i = start_vertex;
+    size_t hops = 0;
+
+    for (size_t head = 0; ready;) {
+        struct gneighbor_iterator it = {0};
+        graph_neighbors(graph, i, &it);
+
+        for (vertex_t j = 0; ready && hops < max_depth && gneighbor_next(&it, &j, NULL);) {
+            struct gnearest_slot* slot = _gnearest_slot(&search, j);
+            if (slot == NULL) {
+                ready = false;
+            } else if (!slot->settled) {
+                slot->settled = true;
+                ready = _gnearest_append(out_array, j, hops + 1);
+            }
+        }
+
+        if (head >= out_array->len) {
+            break;
+        }
+
+        i = out_array->data[head].vertex;
+        hops = (size_t) out_array->data[head].distance;
+        head++;
+    }
+
+    free(search.slots);
+
+    if (!ready) {
+        gnearest_array_destroy(out_array);
+    }
+
+    return ready;
+}
+
+void gnearest_array_destroy(struct gnearest_array* array) {
+    if (array == NULL) {
+        return;
+    }
+
+    free(array->data);
+    *array = (struct gnearest_array) {0};
+}
+
+static bool _gnearest_dijkstra(struct graph* graph,
+                               vertex_t vi,
+                               size_t k,
+                               distance_t max_distance,
+                               struct gnearest_array* out) {
+    if (_gnearest_is_out(graph, vi)) {
+        return false;
+    }
+
+    struct gnearest_search search = {0};
+
+    struct gnearest_slot* start = _gnearest_slot(&search, vi);
+    bool ready = start != NULL && _gnearest_push(&search, vi, 0);
+    if (ready) {
+        start->distance = 0;
+    }
+
+    while (ready && search.queue_len > 0 && out->len < k) {
+        struct gnearest_entry entry = _gnearest_pop(&search);
+        struct gnearest_slot* slot = _gnearest_slot(&search, entry.vertex);
+        if (slot == NULL) {
+            ready = false;
+            break;
+        }
+
+        // a later entry of the vertex was settled before
+        if (slot->settled || entry.distance > slot->distance) {
+            continue;
+        }
+
+        slot->settled = true;
+
+        if (entry.vertex != vi) {
+            ready = _gnearest_append(out, entry.vertex, entry.distance);
+        }
+
+        // the k-th vertex is settled, its neighbors can't be
+        // closer than it
+        if (out->len >= k) {
+            break;
+        }
+
+        struct gneighbor_iterator it = {0};
+        graph_neighbors(graph, entry.vertex, &it);
+
+        weight_t weight = 0;
+        for (vertex_t j = 0; ready && gneighbor_next(&it, &j, &weight);) {
+            distance_t distance = entry.distance + weight;
+
+            // the vertices beyond the budget are never touched,
+            // so the table stays as small as the ball
+            if (distance > max_distance) {
+                continue;
+            }
+
+            struct gnearest_slot* next = _gnearest_slot(&search, j);
+            if (next == NULL) {
+                ready = false;
+            } else if (!next->settled && distance < next->distance) {
+                next->distance = distance;
+                ready = _gnearest_push(&search, j, distance);
+            }
+        }
+    }
+
+    free(search.slots);
+    free(search.queue);
+
+    return ready;
+}
+
+static bool _gnearest_is_out(const struct graph* graph, vertex_t vi) {
+    if (graph == NULL || vi >= graph->len) {
+        return true;
+    }
+
+    return graph->removed != NULL && bitset_get(graph->removed, vi);
+}
+
+static bool _gnearest_append(struct gnearest_array* array, vertex_t vertex, distance_t distance) {
+    if (array->len >= array->capacity) {
+        size_t capacity = array->capacity > 0 ? array->capacity * 2 : GNEAREST_INITIAL_CAPACITY;
+
+        struct gnearest* data = realloc(array->data, sizeof(struct gnearest) * capacity);
+        if (data == NULL) {
+            return false;
+        }
+
+        array->data = data;
+        array->capacity = capacity;
+    }
+
+    array->data[array->len++] = (struct gnearest) {vertex, distance};
+    return true;
+}
+
+static struct gnearest_slot* _gnearest_slot(struct gnearest_search* search, vertex_t vertex) {
+    // the load factor is kept up to a half, so the runs of
+    // probes stay short
+    if ((search->size + 1) * 2 > search->capacity && !_gnearest_grow(search)) {
+        return NULL;
+    }
+
+    size_t mask = search->capacity - 1;
+    size_t pos = (size_t) ((vertex * UINT64_C(0x9E3779B97F4A7C15)) >> 17) & mask;
+
+    while (search->slots[pos].vertex != VERTEX_T_MAX && search->slots[pos].vertex != vertex) {
+        pos = (pos + 1) & mask;
+    }
+
+    struct gnearest_slot* slot = &search->slots[pos];
+    if (slot->vertex == VERTEX_T_MAX) {
+        *slot = (struct gnearest_slot) {vertex, DISTANCE_MAX, false};
+        search->size++;
+    }
+
+    return slot;
+}
+
+static bool _gnearest_grow(struct gnearest_search* search) {
+    size_t capacity = search->capacity > 0 ? search->capacity * 2 : GNEAREST_INITIAL_CAPACITY;
+
+    struct gnearest_slot* slots = malloc(sizeof(struct gnearest_slot) * capacity);
+    if (slots == NULL) {
+        return false;
+    }
+
+    for (size_t k = 0; k < capacity; k++) {
+        slots[k].vertex = VERTEX_T_MAX;
+    }
+
+    struct gnearest_slot* old_slots = search->slots;
+    size_t old_capacity = search->capacity;
+
+    search->slots = slots;
+    search->capacity = capacity;
+    search->size = 0;
+
+    for (size_t k = 0; k < old_capacity; k++) {
+        if (old_slots[k].vertex != VERTEX_T_MAX) {
+            *_gnearest_slot(search, old_slots[k].vertex) = old_slots[k];
+        }
+    }
+
+    free(old_slots);
+    return true;
+}
+
+static bool _gnearest_push(struct gnearest_search* search, vertex_t vertex, distance_t distance) {
+    if (search->queue_len >= search->queue_capacity) {
+        size_t capacity = search->queue_capacity > 0 ? search->queue_capacity * 2 : GNEAREST_INITIAL_CAPACITY;
+
+        struct gnearest_entry* queue = realloc(search->queue, sizeof(struct gnearest_entry) * capacity);
+        if (queue == NULL) {
+            return false;
+        }
+
+        search->queue = queue;
+        search->queue_capacity = capacity;
+    }
+
+    size_t pos = search->queue_len++;
+
+    while (pos > 0) {
+        size_t parent = (pos - 1) / 2;
+        if (search->queue[parent].distance <= distance) {
+            break;
+        }
+
+        search->queue[pos] = search->queue[parent];
+        pos = parent;
+    }
+
+    search->queue[pos] = (struct gnearest_entry) {vertex, distance};
+    return true;
+}
+
+static struct gnearest_entry _gnearest_pop(struct gnearest_search* search) {
+    struct gnearest_entry top = search->queue[0];
+    struct gnearest_entry last = search->queue[--search->queue_len];
+
+    size_t len = search->queue_len;
+    size_t pos = 0;
+
+    for (;;) {
+        size_t child = pos * 2 + 1;
+        if (child >= len) {
+            break;
+        }
+
+        if (child + 1 < len && search->queue[child + 1].distance < search->queue[child].distance) {
+            child++;
+        }
+
+        if (search->queue[child].distance >= last.distance) {
+            break;
+        }
+
+        search->queue[pos] = search->queue[child];
+        pos = child;
+    }
+
+    if (len > 0) {
+        search->queue[pos] = last;
+    }
+
+    return top;
+}
@@ -1,3 +1,4 @@
+#include <stdlib.h>
 #include <string.h>
 
 #include <path.h>
@@ -29,3 +30,108 @@ void u32path_destroyer(void* path) {
     free(path);
 }
 
+
+bool sssp_tree_init(struct sssp_tree* tree, size_t len, vertex_t source) {
+    if (tree == NULL || source >= len) {
+        return false;
+    }
+
+    tree->len = len;
+    tree->source = source;
+    tree->distances = malloc(sizeof(distance_t) * len);
+    tree->parents = malloc(sizeof(vertex_t) * len);
+
+    if (tree->distances == NULL || tree->parents == NULL) {
+        sssp_tree_destroy(tree);
+        return false;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        tree->distances[i] = DISTANCE_MAX;
+        tree->parents[i] = VERTEX_T_MAX;
+    }
+
+    tree->distances[source] = 0;
+    return true;
+}
+
+void sssp_tree_destroy(struct sssp_tree* tree) {
+    if (tree == NULL) {
+        return;
+    }
+
+    free(tree->distances);
+    free(tree->parents);
+
+    tree->len = 0;
+    tree->source = VERTEX_T_MAX;
+    tree->distances = NULL;
+    tree->parents = NULL;
+}
+
+size_t sssp_tree_path(const struct sssp_tree* tree,
+                      vertex_t vertex,
+                      vertex_t* out_vertices,
+                      size_t capacity) {
+    if (tree == NULL || vertex >= tree->len || tree->distances[vertex] == DISTANCE_MAX) {
+        return 0;
+    }
+
+    // the length of vertices until the source vertex
+    size_t len = 1;
+    for (vertex_t v = vertex; v != tree->source; v = tree->parents[v]) {
+        len++;
+    }
+
+    if (out_vertices == NULL || capacity < len) {
+        return len;
+    }
+
+    // walk the parents backwards, from the end
+    vertex_t v = vertex;
+    for (size_t k = len; k-- > 0; v = tree->parents[v]) {
+        out_vertices[k] = v;
+    }
+
+    return len;
+}
+
+bool bfs_dag_init(struct bfs_dag* dag, size_t len, vertex_t source) {
+    if (dag == NULL || source >= len) {
+        return false;
+    }
+
+    dag->len = len;
+    dag->source = source;
+    dag->hops = malloc(sizeof(vertex_t) * len);
+    dag->offsets = calloc(len + 1, sizeof(size_t));
+    dag->parents = NULL;
+
+    if (dag->hops == NULL || dag->offsets == NULL) {
+        bfs_dag_destroy(dag);
+        return false;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        dag->hops[i] = VERTEX_T_MAX;
+    }
+
+    dag->hops[source] = 0;
+    return true;
+}
+
+void bfs_dag_destroy(struct bfs_dag* dag) {
+    if (dag == NULL) {
+        return;
+    }
+
+    free(dag->hops);
+    free(dag->offsets);
+    free(dag->parents);
+
+    dag->len = 0;
+    dag->source = VERTEX_T_MAX;
+    dag->hops = NULL;
+    dag->offsets = NULL;
+    dag->parents = NULL;
+}
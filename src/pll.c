@@ -0,0 +1,392 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <pll.h>
+#include <graph.h>
+
+/**
+ * Represents the magic bytes that start a file written by
+ * gpll_save.
+ */
+#define GPLL_MAGIC "EDPLL02"
+
+/**
+ * Represents the marker of the byte order, it reads as another
+ * value on a machine with a different endianness.
+ */
+#define GPLL_BYTE_ORDER UINT64_C(0x0102030405060708)
+
+/**
+ * Represents the header of a file written by gpll_save.
+ *
+ * @member magic the magic bytes, GPLL_MAGIC
+ * @member byte_order the marker of the byte order,
+ *                    GPLL_BYTE_ORDER
+ * @member vertex_size the size of vertex_t in bytes
+ * @member offset_size the size of size_t in bytes
+ * @member len the length of vertices
+ * @member label_len the length of entries of the labels
+ */
+struct gpll_header {
+    char magic[8];
+    uint64_t byte_order;
+    uint32_t vertex_size;
+    uint32_t offset_size;
+    uint64_t len;
+    uint64_t label_len;
+};
+
+/**
+ * Represents the label of a vertex while the labels are being
+ * built.
+ *
+ * @member len the length of entries
+ * @member capacity the length of entries that it can hold
+ * @member hubs the rank of the hub of each entry
+ * @member hops the hops to the hub of each entry
+ */
+struct gpll_entries {
+    size_t len;
+    size_t capacity;
+
+    vertex_t* hubs;
+    uint32_t* hops;
+};
+
+/**
+ * Add an entry at the end of a label.
+ *
+ * @param entries the label where to add the entry
+ * @param hub the rank of the hub
+ * @param hops the hops to the hub
+ * @return true if it could add the entry, otherwise false
+ */
+static bool _gpll_push(struct gpll_entries* entries, vertex_t hub, uint32_t hops);
+/**
+ * Allocate the flat arrays of labels.
+ *
+ * @param pll the labels to allocate
+ * @param len the length of vertices
+ * @param label_len the length of entries of the labels
+ * @return true if it could allocate them, otherwise false
+ */
+static bool _gpll_alloc(struct gpll* pll, size_t len, size_t label_len);
+/**
+ * Check if the rest of a file holds exactly the arrays of the
+ * labels that a header describes.
+ *
+ * @param file the file, just after the header
+ * @param header the read header
+ * @return true if the size matches, otherwise false
+ */
+static bool _gpll_fits(FILE* file, const struct gpll_header* header);
+
+bool gpll_init(struct gpll* pll, struct graph* graph) {
+    if (pll == NULL || graph == NULL) {
+        return false;
+    }
+
+    memset(pll, 0, sizeof(struct gpll));
+
+    size_t len = graph->len;
+
+    struct gpll_entries* labels = calloc(len + 1, sizeof(struct gpll_entries));
+    vertex_t* order = malloc(sizeof(vertex_t) * (len + 1));
+    // the hops from the actual hub, both for the search and
+    // for its own label indexed by rank
+    uint32_t* hops = malloc(sizeof(uint32_t) * (len + 1));
+    uint32_t* hub_hops = malloc(sizeof(uint32_t) * (len + 1));
+    vertex_t* queue = malloc(sizeof(vertex_t) * (len + 1));
+
+    bool ready = labels != NULL && order != NULL && hops != NULL && hub_hops != NULL && queue != NULL;
+
+    // the vertices of higher degree cover more paths, so they're
+    // taken first from the degree histogram
+    size_t rank_len = 0;
+    for (size_t degree = graph_max_degree(graph) + 1; ready && degree-- > 0;) {
+        size_t bucket_len = 0;
+        const vertex_t* bucket = graph_degree_vertices(graph, degree, &bucket_len);
+
+        for (size_t k = 0; k < bucket_len; k++) {
+            order[rank_len++] = bucket[k];
+        }
+    }
+
+    for (size_t i = 0; ready && i < len; i++) {
+        hops[i] = UINT32_MAX;
+        hub_hops[i] = UINT32_MAX;
+    }
+
+    for (vertex_t rank = 0; ready && rank < len; rank++) {
+        vertex_t hub = order[rank];
+        struct gpll_entries* hub_label = &labels[hub];
+
+        for (size_t k = 0; k < hub_label->len; k++) {
+            hub_hops[hub_label->hubs[k]] = hub_label->hops[k];
+        }
+
+        size_t queue_head = 0;
+        size_t queue_tail = 0;
+
+        queue[queue_tail++] = hub;
+        hops[hub] = 0;
+
+        while (ready && queue_head < queue_tail) {
+            vertex_t v = queue[queue_head++];
+            struct gpll_entries* label = &labels[v];
+
+            // the previous hubs already give a path as short,
+            // so neither v nor the vertices behind it need hub
+            bool covered = false;
+            for (size_t k = 0; k < label->len && !covered; k++) {
+                uint32_t through = hub_hops[label->hubs[k]];
+                covered = through != UINT32_MAX && through + label->hops[k] <= hops[v];
+            }
+
+            if (covered) {
+                continue;
+            }
+
+            ready = _gpll_push(label, rank, hops[v]);
+
+            struct gneighbor_iterator it = {0};
+            graph_neighbors(graph, v, &it);
+
+            for (vertex_t j = 0; gneighbor_next(&it, &j, NULL);) {
+                if (hops[j] != UINT32_MAX) {
+                    continue;
+                }
+
+                hops[j] = hops[v] + 1;
+                queue[queue_tail++] = j;
+            }
+        }
+
+        // reset just what the search touched
+        for (size_t k = 0; k < queue_tail; k++) {
+            hops[queue[k]] = UINT32_MAX;
+        }
+
+        for (size_t k = 0; k < hub_label->len; k++) {
+            hub_hops[hub_label->hubs[k]] = UINT32_MAX;
+        }
+    }
+
+    // move the labels into flat arrays
+    size_t label_len = 0;
+    for (size_t i = 0; ready && i < len; i++) {
+        label_len += labels[i].len;
+    }
+
+    ready = ready && _gpll_alloc(pll, len, label_len);
+
+    if (ready) {
+        memcpy(pll->order, order, sizeof(vertex_t) * len);
+
+        for (size_t i = 0; i < len; i++) {
+            size_t offset = pll->offsets[i];
+
+            memcpy(&pll->hubs[offset], labels[i].hubs, sizeof(vertex_t) * labels[i].len);
+            memcpy(&pll->hops[offset], labels[i].hops, sizeof(uint32_t) * labels[i].len);
+            pll->offsets[i + 1] = offset + labels[i].len;
+        }
+    }
+
+    for (size_t i = 0; labels != NULL && i < len; i++) {
+        free(labels[i].hubs);
+        free(labels[i].hops);
+    }
+
+    free(labels);
+    free(order);
+    free(hops);
+    free(hub_hops);
+    free(queue);
+
+    return ready;
+}
+
+void gpll_destroy(struct gpll* pll) {
+    if (pll == NULL) {
+        return;
+    }
+
+    free(pll->order);
+    free(pll->offsets);
+    free(pll->hubs);
+    free(pll->hops);
+
+    memset(pll, 0, sizeof(struct gpll));
+}
+
+size_t gpll_hops(const struct gpll* pll, vertex_t vi, vertex_t wj) {
+    if (pll == NULL || vi >= pll->len || wj >= pll->len) {
+        return SIZE_MAX;
+    }
+
+    size_t a = pll->offsets[vi];
+    size_t a_end = pll->offsets[vi + 1];
+    size_t b = pll->offsets[wj];
+    size_t b_end = pll->offsets[wj + 1];
+
+    size_t hops = SIZE_MAX;
+
+    // both labels are sorted by hub, so the common hubs are
+    // found by a merge
+    while (a < a_end && b < b_end) {
+        vertex_t a_hub = pll->hubs[a];
+        vertex_t b_hub = pll->hubs[b];
+
+        if (a_hub == b_hub) {
+            size_t through = (size_t) pll->hops[a] + pll->hops[b];
+            hops = through < hops ? through : hops;
+
+            a++;
+            b++;
+        } else if (a_hub < b_hub) {
+            a++;
+        } else {
+            b++;
+        }
+    }
+
+    return hops;
+}
+
+bool gpll_save(const struct gpll* pll, FILE* file) {
+    if (pll == NULL || file == NULL) {
+        return false;
+    }
+
+    struct gpll_header header = {0};
+    memcpy(header.magic, GPLL_MAGIC, sizeof(header.magic));
+    header.byte_order = GPLL_BYTE_ORDER;
+    header.vertex_size = sizeof(vertex_t);
+    header.offset_size = sizeof(size_t);
+    header.len = pll->len;
+    header.label_len = pll->len > 0 ? pll->offsets[pll->len] : 0;
+
+    size_t len = pll->len;
+    size_t label_len = header.label_len;
+
+    return fwrite(&header, sizeof(header), 1, file) == 1
+        && fwrite(pll->order, sizeof(vertex_t), len, file) == len
+        && fwrite(pll->offsets, sizeof(size_t), len + 1, file) == len + 1
+        && fwrite(pll->hubs, sizeof(vertex_t), label_len, file) == label_len
+        && fwrite(pll->hops, sizeof(uint32_t), label_len, file) == label_len;
+}
+
+bool gpll_load(struct gpll* pll, FILE* file) {
+    if (pll == NULL || file == NULL) {
+        return false;
+    }
+
+    memset(pll, 0, sizeof(struct gpll));
+
+    struct gpll_header header = {0};
+    if (fread(&header, sizeof(header), 1, file) != 1
+        || memcmp(header.magic, GPLL_MAGIC, sizeof(header.magic)) != 0
+        || header.byte_order != GPLL_BYTE_ORDER
+        || header.vertex_size != sizeof(vertex_t)
+        || header.offset_size != sizeof(size_t)) {
+        return false;
+    }
+
+    // the lengths are trusted just if the file holds them, so
+    // a corrupted header doesn't allocate huge arrays
+    if (!_gpll_fits(file, &header)) {
+        return false;
+    }
+
+    size_t len = header.len;
+    size_t label_len = header.label_len;
+
+    if (!_gpll_alloc(pll, len, label_len)) {
+        return false;
+    }
+
+    bool read = fread(pll->order, sizeof(vertex_t), len, file) == len
+        && fread(pll->offsets, sizeof(size_t), len + 1, file) == len + 1
+        && fread(pll->hubs, sizeof(vertex_t), label_len, file) == label_len
+        && fread(pll->hops, sizeof(uint32_t), label_len, file) == label_len;
+
+    // the offsets must cover the labels from the first entry
+    // to the last one to be queried
+    read = read && pll->offsets[0] == 0 && pll->offsets[len] == label_len;
+    for (size_t i = 0; read && i < len; i++) {
+        read = pll->offsets[i] <= pll->offsets[i + 1];
+    }
+
+    if (!read) {
+        gpll_destroy(pll);
+    }
+
+    return read;
+}
+
+static bool _gpll_push(struct gpll_entries* entries, vertex_t hub, uint32_t hops) {
+    if (entries->len >= entries->capacity) {
+        size_t capacity = entries->capacity > 0 ? entries->capacity * 2 : 4;
+
+        vertex_t* hubs = realloc(entries->hubs, sizeof(vertex_t) * capacity);
+        if (hubs == NULL) {
+            return false;
+        }
+        entries->hubs = hubs;
+
+        uint32_t* hops_data = realloc(entries->hops, sizeof(uint32_t) * capacity);
+        if (hops_data == NULL) {
+            return false;
+        }
+        entries->hops = hops_data;
+
+        entries->capacity = capacity;
+    }
+
+    entries->hubs[entries->len] = hub;
+    entries->hops[entries->len] = hops;
+    entries->len++;
+
+    return true;
+}
+
+static bool _gpll_alloc(struct gpll* pll, size_t len, size_t label_len) {
+    pll->len = len;
+    pll->order = malloc(sizeof(vertex_t) * (len + 1));
+    pll->offsets = calloc(len + 1, sizeof(size_t));
+    pll->hubs = malloc(sizeof(vertex_t) * (label_len + 1));
+    pll->hops = malloc(sizeof(uint32_t) * (label_len + 1));
+
+    if (pll->order == NULL || pll->offsets == NULL || pll->hubs == NULL || pll->hops == NULL) {
+        gpll_destroy(pll);
+        return false;
+    }
+
+    return true;
+}
+
+static bool _gpll_fits(FILE* file, const struct gpll_header* header) {
+    long start = ftell(file);
+    if (start < 0 || fseek(file, 0, SEEK_END) != 0) {
+        return false;
+    }
+
+    long end = ftell(file);
+    if (end < start || fseek(file, start, SEEK_SET) != 0) {
+        return false;
+    }
+
+    uint64_t size = (uint64_t) (end - start);
+    uint64_t vertex_size = sizeof(vertex_t);
+    uint64_t entry_size = sizeof(vertex_t) + sizeof(uint32_t);
+
+    // each length is bounded before multiplying it, so the
+    // expected size can't overflow
+    if (header->len >= size / (vertex_size + sizeof(size_t)) + 1 || header->label_len > size / entry_size) {
+        return false;
+    }
+
+    uint64_t expected = header->len * vertex_size + (header->len + 1) * sizeof(size_t) + header->label_len * entry_size;
+
+    return expected == size;
+}
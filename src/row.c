@@ -0,0 +1,250 @@
+#include <pthread.h>
+
+#include <row.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ROW_X86 1
+#include <immintrin.h>
+#endif
+
+#ifdef ROW_X86
+/*
+ * The comparisons of a vector of cells against the empty
+ * weight, they're specialized by the type of the weights and
+ * they give all the bits of a lane set if it's equal.
+ */
+#if WEIGHT_FLOAT
+#define ROW_SET1_128(x) _mm_castps_si128(_mm_set1_ps(x))
+#define ROW_CMPEQ_128(a, b) _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)))
+#define ROW_SET1_256(x) _mm256_castps_si256(_mm256_set1_ps(x))
+#define ROW_CMPEQ_256(a, b) \
+    _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ))
+#elif WEIGHT_BITS == 8
+#define ROW_SET1_128(x) _mm_set1_epi8(x)
+#define ROW_CMPEQ_128(a, b) _mm_cmpeq_epi8(a, b)
+#define ROW_SET1_256(x) _mm256_set1_epi8(x)
+#define ROW_CMPEQ_256(a, b) _mm256_cmpeq_epi8(a, b)
+#elif WEIGHT_BITS == 16
+#define ROW_SET1_128(x) _mm_set1_epi16(x)
+#define ROW_CMPEQ_128(a, b) _mm_cmpeq_epi16(a, b)
+#define ROW_SET1_256(x) _mm256_set1_epi16(x)
+#define ROW_CMPEQ_256(a, b) _mm256_cmpeq_epi16(a, b)
+#elif WEIGHT_BITS == 32
+#define ROW_SET1_128(x) _mm_set1_epi32(x)
+#define ROW_CMPEQ_128(a, b) _mm_cmpeq_epi32(a, b)
+#define ROW_SET1_256(x) _mm256_set1_epi32(x)
+#define ROW_CMPEQ_256(a, b) _mm256_cmpeq_epi32(a, b)
+#else
+// SSE2 doesn't compare 64 bits lanes, so both halves of the
+// lane must be equal
+#define ROW_SET1_128(x) _mm_set1_epi64x(x)
+#define ROW_CMPEQ_128(a, b) \
+    _mm_and_si128(_mm_cmpeq_epi32(a, b), _mm_shuffle_epi32(_mm_cmpeq_epi32(a, b), _MM_SHUFFLE(2, 3, 0, 1)))
+#define ROW_SET1_256(x) _mm256_set1_epi64x(x)
+#define ROW_CMPEQ_256(a, b) _mm256_cmpeq_epi64(a, b)
+#endif
+
+/**
+ * Represents the length of cells of a SSE2 vector.
+ */
+#define ROW_CELLS_128 (16 / sizeof(weight_t))
+/**
+ * Represents the length of cells of an AVX2 vector.
+ */
+#define ROW_CELLS_256 (32 / sizeof(weight_t))
+#endif
+
+/**
+ * Represents a kernel that counts the non-empty cells.
+ */
+typedef size_t (*row_count_f)(const weight_t* row, size_t len, weight_t empty);
+/**
+ * Represents a kernel that finds the next non-empty cell.
+ */
+typedef size_t (*row_find_f)(const weight_t* row, size_t from, size_t len, weight_t empty);
+/**
+ * Represents a kernel that counts the set bits.
+ */
+typedef size_t (*row_popcount_f)(const uint64_t* words, size_t len);
+
+static size_t _row_count_scalar(const weight_t* row, size_t len, weight_t empty);
+static size_t _row_find_scalar(const weight_t* row, size_t from, size_t len, weight_t empty);
+static size_t _row_popcount_scalar(const uint64_t* words, size_t len);
+
+#ifdef ROW_X86
+static size_t _row_count_sse2(const weight_t* row, size_t len, weight_t empty);
+static size_t _row_find_sse2(const weight_t* row, size_t from, size_t len, weight_t empty);
+static size_t _row_count_avx2(const weight_t* row, size_t len, weight_t empty);
+static size_t _row_find_avx2(const weight_t* row, size_t from, size_t len, weight_t empty);
+static size_t _row_popcount_popcnt(const uint64_t* words, size_t len);
+#endif
+
+/**
+ * Pick the best kernels that the processor supports, it's
+ * done just once through _row_once, since the kernels can be
+ * first called by several threads at the same time.
+ */
+static void _row_select(void);
+
+static pthread_once_t _row_once = PTHREAD_ONCE_INIT;
+
+static row_count_f _row_count = NULL;
+static row_find_f _row_find = NULL;
+static row_popcount_f _row_popcount = NULL;
+
+size_t row_count(const weight_t* row, size_t len, weight_t empty) {
+    pthread_once(&_row_once, _row_select);
+
+    return _row_count(row, len, empty);
+}
+
+size_t row_find(const weight_t* row, size_t from, size_t len, weight_t empty) {
+    if (from >= len) {
+        return len;
+    }
+
+    pthread_once(&_row_once, _row_select);
+
+    return _row_find(row, from, len, empty);
+}
+
+size_t row_popcount(const uint64_t* words, size_t len) {
+    pthread_once(&_row_once, _row_select);
+
+    return _row_popcount(words, len);
+}
+
+static void _row_select(void) {
+    _row_count = _row_count_scalar;
+    _row_find = _row_find_scalar;
+    _row_popcount = _row_popcount_scalar;
+
+#ifdef ROW_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("popcnt")) {
+        _row_popcount = _row_popcount_popcnt;
+    }
+
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+        _row_count = _row_count_avx2;
+        _row_find = _row_find_avx2;
+    } else if (__builtin_cpu_supports("sse2")) {
+        _row_count = _row_count_sse2;
+        _row_find = _row_find_sse2;
+    }
+#endif
+}
+
+static size_t _row_count_scalar(const weight_t* row, size_t len, weight_t empty) {
+    size_t count = 0;
+
+    for (size_t j = 0; j < len; j++) {
+        if (row[j] != empty) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+static size_t _row_find_scalar(const weight_t* row, size_t from, size_t len, weight_t empty) {
+    for (size_t j = from; j < len; j++) {
+        if (row[j] != empty) {
+            return j;
+        }
+    }
+
+    return len;
+}
+
+static size_t _row_popcount_scalar(const uint64_t* words, size_t len) {
+    size_t count = 0;
+
+    for (size_t w = 0; w < len; w++) {
+        count += __builtin_popcountll(words[w]);
+    }
+
+    return count;
+}
+
+#ifdef ROW_X86
+
+__attribute__((target("popcnt")))
+static size_t _row_popcount_popcnt(const uint64_t* words, size_t len) {
+    size_t count = 0;
+
+    for (size_t w = 0; w < len; w++) {
+        count += __builtin_popcountll(words[w]);
+    }
+
+    return count;
+}
+
+// the byte mask of a comparison has sizeof(weight_t) bits for
+// every cell, so the counts and positions are divided by it
+
+__attribute__((target("sse2")))
+static size_t _row_count_sse2(const weight_t* row, size_t len, weight_t empty) {
+    __m128i empty_vec = ROW_SET1_128(empty);
+    size_t empty_bits = 0;
+
+    size_t j = 0;
+    for (; j + ROW_CELLS_128 <= len; j += ROW_CELLS_128) {
+        __m128i cells = _mm_loadu_si128((const __m128i*) &row[j]);
+        empty_bits += __builtin_popcount(_mm_movemask_epi8(ROW_CMPEQ_128(cells, empty_vec)));
+    }
+
+    size_t count = j - empty_bits / sizeof(weight_t);
+    return count + _row_count_scalar(&row[j], len - j, empty);
+}
+
+__attribute__((target("sse2")))
+static size_t _row_find_sse2(const weight_t* row, size_t from, size_t len, weight_t empty) {
+    __m128i empty_vec = ROW_SET1_128(empty);
+
+    size_t j = from;
+    for (; j + ROW_CELLS_128 <= len; j += ROW_CELLS_128) {
+        __m128i cells = _mm_loadu_si128((const __m128i*) &row[j]);
+        unsigned equal = _mm_movemask_epi8(ROW_CMPEQ_128(cells, empty_vec));
+
+        if (equal != 0xFFFF) {
+            return j + __builtin_ctz(~equal & 0xFFFF) / sizeof(weight_t);
+        }
+    }
+
+    return _row_find_scalar(row, j, len, empty);
+}
+
+__attribute__((target("avx2,popcnt")))
+static size_t _row_count_avx2(const weight_t* row, size_t len, weight_t empty) {
+    __m256i empty_vec = ROW_SET1_256(empty);
+    size_t empty_bits = 0;
+
+    size_t j = 0;
+    for (; j + ROW_CELLS_256 <= len; j += ROW_CELLS_256) {
+        __m256i cells = _mm256_loadu_si256((const __m256i*) &row[j]);
+        empty_bits += __builtin_popcount(_mm256_movemask_epi8(ROW_CMPEQ_256(cells, empty_vec)));
+    }
+
+    return j - empty_bits / sizeof(weight_t) + _row_count_scalar(&row[j], len - j, empty);
+}
+
+__attribute__((target("avx2")))
+static size_t _row_find_avx2(const weight_t* row, size_t from, size_t len, weight_t empty) {
+    __m256i empty_vec = ROW_SET1_256(empty);
+
+    size_t j = from;
+    for (; j + ROW_CELLS_256 <= len; j += ROW_CELLS_256) {
+        __m256i cells = _mm256_loadu_si256((const __m256i*) &row[j]);
+        unsigned equal = _mm256_movemask_epi8(ROW_CMPEQ_256(cells, empty_vec));
+
+        if (equal != 0xFFFFFFFF) {
+            return j + __builtin_ctz(~equal) / sizeof(weight_t);
+        }
+    }
+
+    return _row_find_scalar(row, j, len, empty);
+}
+
+#endif
@@ -53,9 +53,9 @@ void vertex_array_print(struct vertex_array* array) {
         return;
     }
 
-    printf("%lu", array->data[0] + 1);
+    printf("%" VERTEX_PRI, array->data[0] + 1);
     for (size_t i = 1; i < array->len; i++) {
-        printf("-%lu", array->data[i] + 1);
+        printf("-%" VERTEX_PRI, array->data[i] + 1);
     }
 }
 
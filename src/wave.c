@@ -3,102 +3,200 @@
 
 #include <wave.h>
 
-void wave_init(struct wave* wave, struct wave* parent, vertex_t vertex) {
+/**
+ * Represents the first capacity of a wave, it grows
+ * geometrically.
+ */
+#define WAVE_INITIAL_CAPACITY 16
+
+/**
+ * Return the node after another in pre-order (a node before its
+ * sub-nodes, and the sub-nodes in the order that were added).
+ *
+ * @param wave the wave where the nodes are
+ * @param node the actual node
+ * @return the next node, WAVE_NONE if it was the last one
+ */
+static size_t _wave_next(const struct wave* wave, size_t node);
+/**
+ * Return the slot of the table where a sub-node is or it would
+ * be added.
+ *
+ * @param wave the wave where the table is
+ * @param node the parent node
+ * @param vertex the vertex of the sub-node
+ * @return the position of the slot
+ */
+static size_t _wave_index_slot(const struct wave* wave, size_t node, vertex_t vertex);
+/**
+ * Grow the table until it can hold more sub-nodes keeping the
+ * load factor up to a half.
+ *
+ * @param wave the wave where the table is
+ * @param extra the length of sub-nodes to add
+ * @return true if it could grow, otherwise false
+ */
+static bool _wave_index_reserve(struct wave* wave, size_t extra);
+/**
+ * Add a sub-node in the table, it must have room.
+ *
+ * @param wave the wave where the table is
+ * @param child the sub-node to add
+ */
+static void _wave_index_put(struct wave* wave, size_t child);
+
+void wave_init(struct wave* wave, vertex_t vertex) {
     if (wave == NULL) {
         return;
     }
 
-    wave->parent = parent;
-    wave->depth = parent != NULL ? parent->depth + 1 : 0; 
-    wave->vertex = vertex;
-    list_init(&wave->subwaves, wave_destroyer);
-}
+    wave->len = 0;
+    wave->capacity = WAVE_INITIAL_CAPACITY;
+    wave->nodes = malloc(sizeof(struct wave_node) * wave->capacity);
+    wave->index = NULL;
+    wave->index_len = 0;
+    wave->index_capacity = 0;
 
-void wave_print(struct wave* wave) {
-    if (wave == NULL) {
+    if (wave->nodes == NULL) {
+        wave->capacity = 0;
         return;
     }
 
-    stack_t wave_stack = {0};
-    stack_init(&wave_stack, NULL);
-    stack_push(&wave_stack, wave);
+    wave->nodes[wave->len++] = (struct wave_node) {
+        .vertex = vertex,
+        .depth = 0,
+        .parent = WAVE_NONE,
+        .first_child = WAVE_NONE,
+        .last_child = WAVE_NONE,
+        .next_sibling = WAVE_NONE,
+        .children = 0,
+    };
+}
 
-    while (!stack_empty(&wave_stack)) {
-        struct wave* pop_wave = stack_pop(&wave_stack);
+void wave_print(const struct wave* wave) {
+    if (wave == NULL || wave->len == 0) {
+        return;
+    }
 
-        for (size_t i = 0; i < pop_wave->depth; i++) {
-            printf(" ");
-        }
-        printf("%lu\n", pop_wave->vertex + 1);
+    for (size_t node = 0; node != WAVE_NONE; node = _wave_next(wave, node)) {
+        const struct wave_node* wave_node = &wave->nodes[node];
 
-        struct list_node* node = pop_wave->subwaves.last;
-        for (; node != NULL; node = node->back) {
-            stack_push(&wave_stack, node->data);
+        for (size_t i = 0; i < wave_node->depth; i++) {
+            printf(" ");
         }
+        printf("%" VERTEX_PRI "\n", wave_node->vertex + 1);
     }
-
-    stack_destroy(&wave_stack);
 }
 
-struct wave* wave_add(struct wave* wave, vertex_t vertex) {
-    if (wave == NULL) {
-        return NULL;
+size_t wave_add(struct wave* wave, size_t node, vertex_t vertex) {
+    if (wave == NULL || node >= wave->len) {
+        return WAVE_NONE;
     }
 
-    // check if vertex already exists in this wave
+    // check if vertex already exists in this node
     // to avoid duplicates
-    struct wave* found = wave_get(wave, vertex);
-    if (found != NULL) {
+    size_t found = wave_get(wave, node, vertex);
+    if (found != WAVE_NONE) {
         return found;
     }
 
-    struct wave* next_wave = calloc(1, sizeof(struct wave));
-    wave_init(next_wave, wave, vertex);
+    if (wave->len >= wave->capacity) {
+        size_t capacity = wave->capacity > 0 ? wave->capacity * 2 : WAVE_INITIAL_CAPACITY;
+
+        struct wave_node* nodes = realloc(wave->nodes, sizeof(struct wave_node) * capacity);
+        if (nodes == NULL) {
+            return WAVE_NONE;
+        }
+
+        wave->nodes = nodes;
+        wave->capacity = capacity;
+    }
 
-    list_add_last(&wave->subwaves, next_wave);
+    // the siblings are indexed at once when they reach the
+    // threshold, so the room is taken before linking the node
+    size_t children = wave->nodes[node].children + 1;
+    if (children == WAVE_INDEX_CHILDREN && !_wave_index_reserve(wave, children)) {
+        return WAVE_NONE;
+    }
+    if (children > WAVE_INDEX_CHILDREN && !_wave_index_reserve(wave, 1)) {
+        return WAVE_NONE;
+    }
 
-    return next_wave;
+    size_t next_node = wave->len++;
+    struct wave_node* parent = &wave->nodes[node];
+
+    wave->nodes[next_node] = (struct wave_node) {
+        .vertex = vertex,
+        .depth = parent->depth + 1,
+        .parent = node,
+        .first_child = WAVE_NONE,
+        .last_child = WAVE_NONE,
+        .next_sibling = WAVE_NONE,
+        .children = 0,
+    };
+
+    if (parent->last_child == WAVE_NONE) {
+        parent->first_child = next_node;
+    } else {
+        wave->nodes[parent->last_child].next_sibling = next_node;
+    }
+    parent->last_child = next_node;
+    parent->children = children;
+
+    if (children == WAVE_INDEX_CHILDREN) {
+        size_t child = parent->first_child;
+        for (; child != WAVE_NONE; child = wave->nodes[child].next_sibling) {
+            _wave_index_put(wave, child);
+        }
+    } else if (children > WAVE_INDEX_CHILDREN) {
+        _wave_index_put(wave, next_node);
+    }
+
+    return next_node;
 }
 
-struct wave* wave_get(struct wave* wave, vertex_t vertex) {
-    if (wave == NULL) {
-        return NULL;
+size_t wave_get(const struct wave* wave, size_t node, vertex_t vertex) {
+    if (wave == NULL || node >= wave->len) {
+        return WAVE_NONE;
+    }
+
+    if (wave->nodes[node].children >= WAVE_INDEX_CHILDREN) {
+        return wave->index[_wave_index_slot(wave, node, vertex)];
     }
 
-    struct list_node* node = wave->subwaves.head;
-    for (; node != NULL; node = node->next) {
-        struct wave* value = node->data;
-        if (value->vertex == vertex) {
-            return value;
+    size_t child = wave->nodes[node].first_child;
+    for (; child != WAVE_NONE; child = wave->nodes[child].next_sibling) {
+        if (wave->nodes[child].vertex == vertex) {
+            return child;
         }
     }
 
-    return NULL;
+    return WAVE_NONE;
 }
 
-void wave_to_path(struct wave* wave, u32path_map* out_map) {
+void wave_to_path(const struct wave* wave, u32path_map* out_map) {
     if (wave == NULL || out_map == NULL) {
         return;
     }
 
     hashmap_init(out_map, 0, u32path_destroyer);
-    mkey_t next_key = 0;
+    if (wave->len == 0) {
+        return;
+    }
 
-    stack_t stack = {0};
-    stack_init(&stack, NULL);
-    stack_push(&stack, wave);
+    mkey_t next_key = 0;
 
-    size_t root_depth = wave->depth;
-    // the model sequence to be cloned
+    // the model sequence to be cloned, the path of the actual
+    // node is its prefix until the node's depth
     struct vertex_array model = {0};
 
-    while (!stack_empty(&stack)) {
-        struct wave* pop_wave = stack_pop(&stack);
+    for (size_t node = 0; node != WAVE_NONE; node = _wave_next(wave, node)) {
+        const struct wave_node* wave_node = &wave->nodes[node];
 
-        // add the wave vertex in the model sequence
+        // add the node vertex in the model sequence
         vertex_array_reserve(&model, 1);
-        model.data[pop_wave->depth - root_depth] = pop_wave->vertex;
-        model.len = pop_wave->depth - root_depth + 1;
+        model.data[wave_node->depth] = wave_node->vertex;
+        model.len = wave_node->depth + 1;
 
         // a clone is made to add it as generated paths
         // in out_map
@@ -109,14 +207,6 @@ void wave_to_path(struct wave* wave, u32path_map* out_map) {
         struct path* path = calloc(1, sizeof(struct path));
         path_init(path, &vertices);
         hashmap_put(out_map, next_key++, path);
-
-        // add all underlying sub-waves to keep seeking the
-        // same sequence model
-
-        struct list_node* node = pop_wave->subwaves.last;
-        for (; node != NULL; node = node->back) {
-            stack_push(&stack, node->data);
-        }
     }
 
     vertex_array_destroy(&model);
@@ -130,10 +220,15 @@ void wave_destroy(struct wave* wave) {
         return;
     }
 
-    wave->parent = NULL;
-    wave->depth = 0;
-    wave->vertex = 0;
-    list_destroy(&wave->subwaves);
+    free(wave->nodes);
+    free(wave->index);
+
+    wave->len = 0;
+    wave->capacity = 0;
+    wave->nodes = NULL;
+    wave->index = NULL;
+    wave->index_len = 0;
+    wave->index_capacity = 0;
 }
 
 void wave_destroyer(void* wave) {
@@ -141,3 +236,80 @@ void wave_destroyer(void* wave) {
     free(wave);
 }
 
+static size_t _wave_next(const struct wave* wave, size_t node) {
+    const struct wave_node* nodes = wave->nodes;
+
+    if (nodes[node].first_child != WAVE_NONE) {
+        return nodes[node].first_child;
+    }
+
+    // climb until a node has a next sibling
+    for (; node != WAVE_NONE; node = nodes[node].parent) {
+        if (nodes[node].next_sibling != WAVE_NONE) {
+            return nodes[node].next_sibling;
+        }
+    }
+
+    return WAVE_NONE;
+}
+
+static size_t _wave_index_slot(const struct wave* wave, size_t node, vertex_t vertex) {
+    size_t mask = wave->index_capacity - 1;
+
+    uint64_t key = (uint64_t) node * UINT64_C(0x9E3779B97F4A7C15) ^ (uint64_t) vertex * UINT64_C(0xC2B2AE3D27D4EB4F);
+    size_t pos = (size_t) (key ^ (key >> 29)) & mask;
+
+    for (;; pos = (pos + 1) & mask) {
+        size_t child = wave->index[pos];
+
+        if (child == WAVE_NONE || (wave->nodes[child].parent == node && wave->nodes[child].vertex == vertex)) {
+            return pos;
+        }
+    }
+}
+
+static bool _wave_index_reserve(struct wave* wave, size_t extra) {
+    if ((wave->index_len + extra) * 2 <= wave->index_capacity) {
+        return true;
+    }
+
+    size_t capacity = wave->index_capacity > 0 ? wave->index_capacity : WAVE_INITIAL_CAPACITY;
+    while ((wave->index_len + extra) * 2 > capacity) {
+        capacity *= 2;
+    }
+
+    size_t* index = malloc(sizeof(size_t) * capacity);
+    if (index == NULL) {
+        return false;
+    }
+
+    for (size_t k = 0; k < capacity; k++) {
+        index[k] = WAVE_NONE;
+    }
+
+    size_t* old_index = wave->index;
+    size_t old_capacity = wave->index_capacity;
+
+    wave->index = index;
+    wave->index_capacity = capacity;
+    wave->index_len = 0;
+
+    for (size_t k = 0; k < old_capacity; k++) {
+        if (old_index[k] != WAVE_NONE) {
+            _wave_index_put(wave, old_index[k]);
+        }
+    }
+
+    free(old_index);
+    return true;
+}
+
+static void _wave_index_put(struct wave* wave, size_t child) {
+    const struct wave_node* node = &wave->nodes[child];
+    size_t pos = _wave_index_slot(wave, node->parent, node->vertex);
+
+    if (wave->index[pos] == WAVE_NONE) {
+        wave->index[pos] = child;
+        wave->index_len++;
+    }
+}
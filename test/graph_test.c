@@ -0,0 +1,1581 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <graph.h>
+#include <bitset.h>
+#include <ch.h>
+#include <pll.h>
+
+#define RANDOM_VERTEX_LEN 150
+#define RANDOM_EDGE_LEN 300
+
+int storage_sample();
+int path_sample();
+int vertex_sample();
+int degree_sample();
+int ch_sample();
+int pll_sample();
+int delta_sample();
+int dial_sample();
+int nearest_sample();
+int bounded_sample();
+int dag_sample();
+int count_sample();
+int iter_sample();
+int wave_sample();
+
+int main() {
+    int failures = 0;
+
+    failures += storage_sample();
+    failures += path_sample();
+    failures += vertex_sample();
+    failures += degree_sample();
+    failures += ch_sample();
+    failures += pll_sample();
+    failures += delta_sample();
+    failures += dial_sample();
+    failures += nearest_sample();
+    failures += bounded_sample();
+    failures += dag_sample();
+    failures += count_sample();
+    failures += iter_sample();
+    failures += wave_sample();
+
+    if (failures > 0) {
+        printf("Graph Test Failed (%d).\n", failures);
+        return 1;
+    }
+
+    printf("Graph Test Done.\n");
+    return 0;
+}
+
+/**
+ * Fill an edge list with random edges, including repeated
+ * ones and removals (the empty weight).
+ */
+static void random_edges(struct edge* edges, size_t len, bool weighted) {
+    for (size_t k = 0; k < len; k++) {
+        edges[k].vi = rand() % RANDOM_VERTEX_LEN;
+        edges[k].wj = rand() % RANDOM_VERTEX_LEN;
+        edges[k].weight = rand() % 10;
+
+        if (weighted && rand() % 8 == 0) {
+            edges[k].weight = NONE_WEIGHT_VALUE;
+        }
+    }
+}
+
+/**
+ * Compare every cell of two graphs.
+ */
+static int compare_graphs(const struct graph* a, const struct graph* b) {
+    int failures = 0;
+
+    for (vertex_t i = 0; i < a->len; i++) {
+        if (graph_rcount(a, i) != graph_rcount(b, i)) {
+            printf("rcount(%" VERTEX_PRI ") differs\n", i);
+            failures++;
+        }
+
+        for (vertex_t j = 0; j < a->len; j++) {
+            if (graph_get(a, i, j) != graph_get(b, i, j)) {
+                printf("get(%" VERTEX_PRI ", %" VERTEX_PRI ") differs\n", i, j);
+                failures++;
+            }
+        }
+    }
+
+    return failures;
+}
+
+/**
+ * Compare the neighbors of every vertex of two graphs, they
+ * can come in different order.
+ */
+static int compare_neighbors(const struct graph* a, const struct graph* b) {
+    int failures = 0;
+
+    for (vertex_t i = 0; i < a->len; i++) {
+        struct gneighbor_iterator it = {0};
+        graph_neighbors(b, i, &it);
+
+        size_t count = 0;
+        vertex_t j = 0;
+        weight_t weight = 0;
+
+        while (gneighbor_next(&it, &j, &weight)) {
+            if (graph_get(a, i, j) != weight) {
+                printf("neighbor(%" VERTEX_PRI ", %" VERTEX_PRI ") differs\n", i, j);
+                failures++;
+            }
+
+            count++;
+        }
+
+        if (count != graph_rcount(a, i)) {
+            printf("neighbors(%" VERTEX_PRI ") differs\n", i);
+            failures++;
+        }
+    }
+
+    return failures;
+}
+
+/**
+ * A layout that is not built in, a plain matrix of capacity
+ * columns that is kept in graph->impl.
+ */
+struct dense_layout {
+    size_t capacity;
+    weight_t* cells;
+};
+
+static weight_t dense_empty(const struct graph* graph) {
+    return graph->weighted ? NONE_WEIGHT_VALUE : 0;
+}
+
+static bool dense_reserve(struct graph* graph, size_t capacity) {
+    struct dense_layout* old = graph->impl;
+    if (old != NULL && capacity <= old->capacity) {
+        return true;
+    }
+
+    struct dense_layout* layout = malloc(sizeof(struct dense_layout));
+    weight_t* cells = malloc(sizeof(weight_t) * (capacity * capacity + 1));
+    if (layout == NULL || cells == NULL) {
+        free(layout);
+        free(cells);
+        return false;
+    }
+
+    for (size_t k = 0; k < capacity * capacity; k++) {
+        cells[k] = dense_empty(graph);
+    }
+    for (size_t i = 0; old != NULL && i < graph->len; i++) {
+        memcpy(&cells[i * capacity], &old->cells[i * old->capacity], sizeof(weight_t) * graph->len);
+    }
+
+    if (old != NULL) {
+        free(old->cells);
+        free(old);
+    }
+
+    *layout = (struct dense_layout) {capacity, cells};
+    graph->impl = layout;
+    graph->capacity = capacity;
+
+    return true;
+}
+
+static void dense_destroy(struct graph* graph) {
+    struct dense_layout* layout = graph->impl;
+    if (layout != NULL) {
+        free(layout->cells);
+        free(layout);
+    }
+}
+
+static weight_t dense_get(const struct graph* graph, vertex_t vi, vertex_t wj) {
+    const struct dense_layout* layout = graph->impl;
+    return layout->cells[vi * layout->capacity + wj];
+}
+
+static bool dense_has(const struct graph* graph, vertex_t vi, vertex_t wj) {
+    return dense_get(graph, vi, wj) != dense_empty(graph);
+}
+
+static void dense_set(struct graph* graph, vertex_t vi, vertex_t wj, weight_t weight) {
+    struct dense_layout* layout = graph->impl;
+    layout->cells[vi * layout->capacity + wj] = weight;
+    layout->cells[wj * layout->capacity + vi] = weight;
+}
+
+static void dense_del(struct graph* graph, vertex_t vi, vertex_t wj) {
+    dense_set(graph, vi, wj, dense_empty(graph));
+}
+
+static size_t dense_degree(const struct graph* graph, vertex_t vi) {
+    size_t degree = 0;
+    for (vertex_t j = 0; j < graph->len; j++) {
+        degree += dense_has(graph, vi, j);
+    }
+
+    return degree;
+}
+
+static void dense_neighbor_init(struct gneighbor_iterator* it) {
+    it->pos = 0;
+    it->end = it->graph->len;
+}
+
+static bool dense_neighbor_next(struct gneighbor_iterator* it, vertex_t* out_vertex, weight_t* out_weight) {
+    while (it->pos < it->end) {
+        vertex_t j = it->pos++;
+        if ((it->mask != NULL && bitset_get(it->mask, j)) || !dense_has(it->graph, it->vertex, j)) {
+            continue;
+        }
+
+        *out_vertex = j;
+        if (out_weight != NULL) {
+            *out_weight = dense_get(it->graph, it->vertex, j);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+static const struct graph_ops dense_ops = {
+    .storage = GRAPH_STORAGE_CUSTOM,
+    .reserve = dense_reserve,
+    .destroy = dense_destroy,
+    .build = NULL,
+    .has = dense_has,
+    .get = dense_get,
+    .set = dense_set,
+    .del = dense_del,
+    .degree = dense_degree,
+    .neighbor_init = dense_neighbor_init,
+    .neighbor_next = dense_neighbor_next,
+};
+
+int storage_sample() {
+    int failures = 0;
+
+    struct edge edges[RANDOM_EDGE_LEN];
+
+    for (int weighted = 0; weighted <= 1; weighted++) {
+        random_edges(edges, RANDOM_EDGE_LEN, weighted);
+
+        struct graph matrix = {0};
+        graph_init_edges(&matrix, weighted, RANDOM_VERTEX_LEN, GRAPH_STORAGE_MATRIX, edges, RANDOM_EDGE_LEN);
+
+        struct graph csr = {0};
+        graph_init_edges(&csr, weighted, RANDOM_VERTEX_LEN, GRAPH_STORAGE_CSR, edges, RANDOM_EDGE_LEN);
+
+        // a weighted bitset falls back to the matrix
+        struct graph bitset = {0};
+        graph_init_edges(&bitset, weighted, RANDOM_VERTEX_LEN, GRAPH_STORAGE_BITSET, edges, RANDOM_EDGE_LEN);
+
+        struct graph triangle = {0};
+        graph_init_edges(&triangle, weighted, RANDOM_VERTEX_LEN, GRAPH_STORAGE_TRIANGLE, edges, RANDOM_EDGE_LEN);
+
+        struct graph indexed = {0};
+        graph_init_edges(&indexed, weighted, RANDOM_VERTEX_LEN, GRAPH_STORAGE_INDEXED, edges, RANDOM_EDGE_LEN);
+
+        // a layout that is not built in
+        struct graph custom = {0};
+        graph_init_ops(&custom, weighted, RANDOM_VERTEX_LEN, &dense_ops, edges, RANDOM_EDGE_LEN);
+
+        struct graph automatic = {0};
+        graph_init_edges(&automatic, weighted, RANDOM_VERTEX_LEN, GRAPH_STORAGE_AUTO, edges, RANDOM_EDGE_LEN);
+
+        enum graph_storage picked = graph_pick_storage(weighted, RANDOM_VERTEX_LEN, RANDOM_EDGE_LEN);
+        if (automatic.ops != graph_storage_ops(picked)) {
+            printf("auto storage differs\n");
+            failures++;
+        }
+
+        failures += compare_graphs(&matrix, &csr);
+        failures += compare_graphs(&matrix, &bitset);
+        failures += compare_graphs(&matrix, &triangle);
+        failures += compare_graphs(&matrix, &indexed);
+        failures += compare_graphs(&matrix, &custom);
+        failures += compare_graphs(&matrix, &automatic);
+
+        // the updates must behave the same way in both storages
+        for (size_t k = 0; k < 50; k++) {
+            vertex_t vi = rand() % RANDOM_VERTEX_LEN;
+            vertex_t wj = rand() % RANDOM_VERTEX_LEN;
+
+            if (k % 3 == 0) {
+                graph_del(&matrix, vi, wj);
+                graph_del(&csr, vi, wj);
+                graph_del(&bitset, vi, wj);
+                graph_del(&triangle, vi, wj);
+                graph_del(&indexed, vi, wj);
+                graph_del(&custom, vi, wj);
+            } else {
+                graph_addw(&matrix, vi, wj, k);
+                graph_addw(&csr, vi, wj, k);
+                graph_addw(&bitset, vi, wj, k);
+                graph_addw(&triangle, vi, wj, k);
+                graph_addw(&indexed, vi, wj, k);
+                graph_addw(&custom, vi, wj, k);
+            }
+        }
+
+        failures += compare_graphs(&matrix, &csr);
+        failures += compare_graphs(&matrix, &bitset);
+        failures += compare_graphs(&matrix, &triangle);
+        failures += compare_graphs(&matrix, &indexed);
+        failures += compare_neighbors(&matrix, &indexed);
+
+        // the custom layout grows through its own reserve
+        vertex_t added = graph_add_vertex(&custom);
+        graph_add_vertex(&matrix);
+        graph_addw(&custom, added, 0, 3);
+        graph_addw(&matrix, added, 0, 3);
+
+        failures += compare_graphs(&matrix, &custom);
+        failures += compare_neighbors(&matrix, &custom);
+
+        graph_destroy(&matrix);
+        graph_destroy(&csr);
+        graph_destroy(&bitset);
+        graph_destroy(&triangle);
+        graph_destroy(&indexed);
+        graph_destroy(&custom);
+        graph_destroy(&automatic);
+
+        if (custom.impl != NULL) {
+            printf("custom destroy differs\n");
+            failures++;
+        }
+    }
+
+    // the dense graphs must use the dense layouts
+    if (graph_pick_storage(true, 100, 2000) != GRAPH_STORAGE_MATRIX
+        || graph_pick_storage(true, 100, 200) != GRAPH_STORAGE_CSR
+        || graph_pick_storage(false, 1000, 10000) != GRAPH_STORAGE_BITSET
+        || graph_pick_storage(false, 1000, 1000) != GRAPH_STORAGE_CSR) {
+        printf("pick_storage differs\n");
+        failures++;
+    }
+
+    return failures;
+}
+
+int path_sample() {
+    int failures = 0;
+
+    struct edge edges[RANDOM_EDGE_LEN];
+    random_edges(edges, RANDOM_EDGE_LEN, true);
+
+    struct graph matrix = {0};
+    graph_init_edges(&matrix, true, RANDOM_VERTEX_LEN, GRAPH_STORAGE_MATRIX, edges, RANDOM_EDGE_LEN);
+
+    struct graph csr = {0};
+    graph_init_edges(&csr, true, RANDOM_VERTEX_LEN, GRAPH_STORAGE_CSR, edges, RANDOM_EDGE_LEN);
+
+    struct graph triangle = {0};
+    graph_init_edges(&triangle, true, RANDOM_VERTEX_LEN, GRAPH_STORAGE_TRIANGLE, edges, RANDOM_EDGE_LEN);
+
+    struct graph unweighted = {0};
+    graph_init_edges(&unweighted, false, RANDOM_VERTEX_LEN, GRAPH_STORAGE_MATRIX, edges, RANDOM_EDGE_LEN);
+
+    struct graph bitset = {0};
+    graph_init_edges(&bitset, false, RANDOM_VERTEX_LEN, GRAPH_STORAGE_BITSET, edges, RANDOM_EDGE_LEN);
+
+    for (vertex_t v = 0; v < RANDOM_VERTEX_LEN; v++) {
+        if (graph_reachable(&matrix, 0, v) != graph_reachable(&csr, 0, v)) {
+            printf("reachable(0, %" VERTEX_PRI ") differs\n", v);
+            failures++;
+        }
+        if (graph_reachable(&unweighted, 0, v) != graph_reachable(&bitset, 0, v)) {
+            printf("unweighted reachable(0, %" VERTEX_PRI ") differs\n", v);
+            failures++;
+        }
+    }
+
+    u32path_map matrix_paths = {0};
+    graph_minimal_path(&matrix, 0, VERTEX_T_MAX, &matrix_paths);
+
+    u32path_map csr_paths = {0};
+    graph_minimal_path(&csr, 0, VERTEX_T_MAX, &csr_paths);
+
+    u32path_map triangle_paths = {0};
+    graph_minimal_path(&triangle, 0, VERTEX_T_MAX, &triangle_paths);
+
+    for (vertex_t v = 0; v < RANDOM_VERTEX_LEN; v++) {
+        struct path* matrix_path = hashmap_get(&matrix_paths, v);
+        struct path* csr_path = hashmap_get(&csr_paths, v);
+        struct path* triangle_path = hashmap_get(&triangle_paths, v);
+
+        if ((matrix_path == NULL) != (csr_path == NULL) || (matrix_path == NULL) != (triangle_path == NULL)) {
+            printf("minimal_path(0, %" VERTEX_PRI ") differs\n", v);
+            failures++;
+        } else if (matrix_path != NULL
+                   && (matrix_path->weight != csr_path->weight || matrix_path->weight != triangle_path->weight)) {
+            printf("minimal_path(0, %" VERTEX_PRI ") weight differs\n", v);
+            failures++;
+        }
+    }
+
+    // relax every edge until nothing changes (Bellman-Ford),
+    // the distances must match the minimal paths
+    distance_t distances[RANDOM_VERTEX_LEN];
+    for (vertex_t v = 0; v < RANDOM_VERTEX_LEN; v++) {
+        distances[v] = v == 0 ? 0 : DISTANCE_MAX;
+    }
+
+    for (bool relaxed = true; relaxed;) {
+        relaxed = false;
+
+        for (vertex_t i = 0; i < RANDOM_VERTEX_LEN; i++) {
+            for (vertex_t j = 0; j < RANDOM_VERTEX_LEN && distances[i] != DISTANCE_MAX; j++) {
+                if (graph_has(&matrix, i, j) && distances[i] + graph_get(&matrix, i, j) < distances[j]) {
+                    distances[j] = distances[i] + graph_get(&matrix, i, j);
+                    relaxed = true;
+                }
+            }
+        }
+    }
+
+    for (vertex_t v = 1; v < RANDOM_VERTEX_LEN; v++) {
+        struct path* path = hashmap_get(&matrix_paths, v);
+        distance_t weight = path != NULL ? path->weight : DISTANCE_MAX;
+
+        if (weight != distances[v]) {
+            printf("minimal_path(0, %" VERTEX_PRI ") is not minimal\n", v);
+            failures++;
+            continue;
+        }
+        if (path == NULL) {
+            continue;
+        }
+
+        // the path must add up its weight
+        distance_t sum = 0;
+        for (size_t k = 1; k < path->vertices.len; k++) {
+            sum += graph_get(&matrix, path->vertices.data[k - 1], path->vertices.data[k]);
+        }
+
+        if (path->vertices.data[0] != 0 || sum != weight) {
+            printf("minimal_path(0, %" VERTEX_PRI ") sequence differs\n", v);
+            failures++;
+        }
+
+        // a single target stops early with the same distance
+        u32path_map target_paths = {0};
+        graph_minimal_path(&csr, 0, v, &target_paths);
+
+        struct path* target_path = hashmap_get(&target_paths, v);
+        if (target_path == NULL || target_path->weight != weight) {
+            printf("minimal_path(0, %" VERTEX_PRI ") target differs\n", v);
+            failures++;
+        }
+
+        hashmap_destroy(&target_paths);
+
+        // the bidirectional search must find a path as weak
+        u32path_map bidirectional_paths = {0};
+        graph_minimal_path_mode(&csr, 0, v, GRAPH_PATH_BIDIRECTIONAL, &bidirectional_paths);
+
+        struct path* bidirectional_path = hashmap_get(&bidirectional_paths, v);
+        distance_t bidirectional_sum = 0;
+
+        for (size_t k = 1; bidirectional_path != NULL && k < bidirectional_path->vertices.len; k++) {
+            struct vertex_array* vertices = &bidirectional_path->vertices;
+            bidirectional_sum += graph_get(&matrix, vertices->data[k - 1], vertices->data[k]);
+        }
+
+        if (bidirectional_path == NULL || bidirectional_path->weight != weight || bidirectional_sum != weight
+            || bidirectional_path->vertices.data[0] != 0
+            || bidirectional_path->vertices.data[bidirectional_path->vertices.len - 1] != v) {
+            printf("bidirectional minimal_path(0, %" VERTEX_PRI ") differs\n", v);
+            failures++;
+        }
+
+        hashmap_destroy(&bidirectional_paths);
+
+        // the landmarks must just direct the search
+        u32path_map alt_paths = {0};
+        graph_minimal_path_mode(&triangle, 0, v, GRAPH_PATH_ALT, &alt_paths);
+
+        struct path* alt_path = hashmap_get(&alt_paths, v);
+        if (alt_path == NULL || alt_path->weight != weight || alt_path->vertices.data[0] != 0) {
+            printf("alt minimal_path(0, %" VERTEX_PRI ") differs\n", v);
+            failures++;
+        }
+
+        hashmap_destroy(&alt_paths);
+    }
+
+    // every landmark is a vertex and its own distance is 0
+    const struct glandmarks* landmarks = NULL;
+    graph_landmarks(&triangle, 4, &landmarks);
+
+    if (landmarks == NULL || landmarks->len != 4) {
+        printf("landmarks differs\n");
+        failures++;
+    }
+
+    for (size_t l = 0; landmarks != NULL && l < landmarks->len; l++) {
+        if (landmarks->distances[l * landmarks->vertex_len + landmarks->vertices[l]] != 0) {
+            printf("landmark(%zu) differs\n", l);
+            failures++;
+        }
+    }
+
+    // more landmarks than vertices are clamped, so they're
+    // picked just once
+    const struct glandmarks* clamped = NULL;
+    const struct glandmarks* cached = NULL;
+    graph_landmarks(&triangle, SIZE_MAX, &clamped);
+    graph_landmarks(&triangle, SIZE_MAX, &cached);
+
+    if (clamped == NULL || clamped != cached || clamped->len > RANDOM_VERTEX_LEN) {
+        printf("clamped landmarks differs\n");
+        failures++;
+    }
+
+    // the tree must give the same paths without copying them
+    struct sssp_tree tree = {0};
+    graph_sssp(&triangle, 0, VERTEX_T_MAX, &tree);
+
+    for (vertex_t v = 1; v < RANDOM_VERTEX_LEN; v++) {
+        struct path* path = hashmap_get(&triangle_paths, v);
+        vertex_t buffer[RANDOM_VERTEX_LEN];
+
+        size_t len = sssp_tree_path(&tree, v, NULL, 0);
+        if (path == NULL ? len != 0 : (len != path->vertices.len || sssp_tree_distance(&tree, v) != path->weight)) {
+            printf("sssp_tree(0, %" VERTEX_PRI ") differs\n", v);
+            failures++;
+            continue;
+        }
+
+        sssp_tree_path(&tree, v, buffer, len);
+        for (size_t k = 0; k < len; k++) {
+            if (buffer[k] != path->vertices.data[k]) {
+                printf("sssp_tree_path(0, %" VERTEX_PRI ") differs\n", v);
+                failures++;
+                break;
+            }
+        }
+    }
+
+    sssp_tree_destroy(&tree);
+
+    hashmap_destroy(&matrix_paths);
+    hashmap_destroy(&csr_paths);
+    hashmap_destroy(&triangle_paths);
+
+    graph_destroy(&matrix);
+    graph_destroy(&csr);
+    graph_destroy(&triangle);
+    graph_destroy(&unweighted);
+    graph_destroy(&bitset);
+
+    return failures;
+}
+
+int vertex_sample() {
+    int failures = 0;
+
+    enum graph_storage storages[] = {
+        GRAPH_STORAGE_MATRIX, GRAPH_STORAGE_CSR, GRAPH_STORAGE_BITSET, GRAPH_STORAGE_TRIANGLE, GRAPH_STORAGE_INDEXED,
+    };
+
+    struct edge edges[RANDOM_EDGE_LEN];
+    random_edges(edges, RANDOM_EDGE_LEN, false);
+
+    for (size_t s = 0; s < sizeof(storages) / sizeof(storages[0]); s++) {
+        // the vertices are added one by one into an empty
+        // graph, so it must grow several times
+        struct graph grown = {0};
+        graph_init_edges(&grown, false, 0, storages[s], NULL, 0);
+
+        for (vertex_t v = 0; v < RANDOM_VERTEX_LEN; v++) {
+            if (graph_add_vertex(&grown) != v) {
+                printf("add_vertex(%" VERTEX_PRI ") differs\n", v);
+                failures++;
+            }
+        }
+
+        for (size_t k = 0; k < RANDOM_EDGE_LEN; k++) {
+            graph_addw(&grown, edges[k].vi, edges[k].wj, edges[k].weight);
+        }
+
+        struct graph fresh = {0};
+        graph_init_edges(&fresh, false, RANDOM_VERTEX_LEN, GRAPH_STORAGE_MATRIX, edges, RANDOM_EDGE_LEN);
+
+        failures += compare_graphs(&fresh, &grown);
+
+        // compute the connected components before removing, so
+        // the cache must be updated instead of computed again
+        graph_components(&grown, NULL);
+
+        vertex_t map[RANDOM_VERTEX_LEN];
+        for (vertex_t v = 0; v < RANDOM_VERTEX_LEN; v++) {
+            map[v] = v % 3 == 0 ? VERTEX_T_MAX : v - v / 3 - 1;
+        }
+
+        for (vertex_t v = 0; v < RANDOM_VERTEX_LEN; v += 3) {
+            graph_remove_vertex(&grown, v);
+        }
+
+        for (vertex_t v = 0; v < RANDOM_VERTEX_LEN; v++) {
+            if (graph_has(&grown, 0, v) || graph_has(&grown, v, 3)) {
+                printf("removed vertex still has edges (%" VERTEX_PRI ")\n", v);
+                failures++;
+            }
+        }
+
+        // build the expected graph without the removed vertices
+        struct edge kept[RANDOM_EDGE_LEN];
+        size_t kept_len = 0;
+
+        for (size_t k = 0; k < RANDOM_EDGE_LEN; k++) {
+            if (map[edges[k].vi] != VERTEX_T_MAX && map[edges[k].wj] != VERTEX_T_MAX) {
+                kept[kept_len++] = (struct edge) {map[edges[k].vi], map[edges[k].wj], edges[k].weight};
+            }
+        }
+
+        size_t kept_vertex_len = RANDOM_VERTEX_LEN - (RANDOM_VERTEX_LEN + 2) / 3;
+
+        struct graph expected = {0};
+        graph_init_edges(&expected, false, kept_vertex_len, GRAPH_STORAGE_MATRIX, kept, kept_len);
+
+        vertex_t out_map[RANDOM_VERTEX_LEN];
+        graph_compact(&grown, out_map);
+
+        if (grown.len != kept_vertex_len) {
+            printf("compact len differs\n");
+            failures++;
+        } else {
+            failures += compare_graphs(&expected, &grown);
+        }
+
+        for (vertex_t v = 0; v < RANDOM_VERTEX_LEN; v++) {
+            if (out_map[v] != map[v]) {
+                printf("compact map(%" VERTEX_PRI ") differs\n", v);
+                failures++;
+            }
+        }
+
+        // the kept cache must match the one from scratch
+        for (vertex_t v = 0; v < kept_vertex_len && grown.len == kept_vertex_len; v++) {
+            if (graph_reachable(&grown, 0, v) != graph_reachable(&expected, 0, v)) {
+                printf("compact reachable(0, %" VERTEX_PRI ") differs\n", v);
+                failures++;
+            }
+        }
+
+        graph_destroy(&grown);
+        graph_destroy(&fresh);
+        graph_destroy(&expected);
+    }
+
+    return failures;
+}
+
+/**
+ * Compare the degrees, the edge count and the histogram of a
+ * graph with the ones counted from its cells.
+ */
+static int compare_degrees(const struct graph* graph) {
+    int failures = 0;
+
+    size_t edge_len = 0;
+    size_t min = graph->len > 0 ? SIZE_MAX : 0;
+    size_t max = 0;
+    size_t counted = 0;
+
+    for (vertex_t i = 0; i < graph->len; i++) {
+        size_t degree = 0;
+        for (vertex_t j = 0; j < graph->len; j++) {
+            if (graph_has(graph, i, j)) {
+                degree++;
+                edge_len += j >= i;
+            }
+        }
+
+        if (graph_rcount(graph, i) != degree) {
+            printf("degree(%" VERTEX_PRI ") differs\n", i);
+            failures++;
+        }
+
+        min = degree < min ? degree : min;
+        max = degree > max ? degree : max;
+    }
+
+    if (graph_edge_count(graph) != edge_len) {
+        printf("edge_count differs\n");
+        failures++;
+    }
+    if (graph_min_degree(graph) != min || graph_max_degree(graph) != max) {
+        printf("min/max degree differs\n");
+        failures++;
+    }
+
+    // every vertex must be in the bucket of its degree
+    for (size_t d = 0; d <= max; d++) {
+        size_t len = 0;
+        const vertex_t* vertices = graph_degree_vertices(graph, d, &len);
+
+        for (size_t k = 0; k < len; k++) {
+            if (graph_rcount(graph, vertices[k]) != d) {
+                printf("degree_vertices(%zu) differs\n", d);
+                failures++;
+            }
+        }
+
+        counted += len;
+    }
+
+    if (counted != graph->len) {
+        printf("degree_vertices len differs\n");
+        failures++;
+    }
+
+    return failures;
+}
+
+int degree_sample() {
+    int failures = 0;
+
+    enum graph_storage storages[] = {
+        GRAPH_STORAGE_MATRIX, GRAPH_STORAGE_CSR, GRAPH_STORAGE_BITSET, GRAPH_STORAGE_TRIANGLE, GRAPH_STORAGE_INDEXED,
+    };
+
+    struct edge edges[RANDOM_EDGE_LEN];
+    random_edges(edges, RANDOM_EDGE_LEN, true);
+
+    for (size_t s = 0; s < sizeof(storages) / sizeof(storages[0]); s++) {
+        struct graph graph = {0};
+        graph_init_edges(&graph, true, RANDOM_VERTEX_LEN, storages[s], edges, RANDOM_EDGE_LEN);
+
+        failures += compare_degrees(&graph);
+
+        for (size_t k = 0; k < RANDOM_EDGE_LEN; k++) {
+            vertex_t vi = rand() % RANDOM_VERTEX_LEN;
+            vertex_t wj = rand() % 4 == 0 ? vi : (vertex_t) (rand() % RANDOM_VERTEX_LEN);
+
+            if (k % 3 == 0) {
+                graph_del(&graph, vi, wj);
+            } else {
+                graph_addw(&graph, vi, wj, k % 10);
+            }
+        }
+
+        failures += compare_degrees(&graph);
+
+        // the removed vertices stay with degree 0
+        graph_add_vertex(&graph);
+        graph_remove_vertex(&graph, 1);
+        graph_remove_vertex(&graph, 2);
+
+        failures += compare_degrees(&graph);
+
+        graph_destroy(&graph);
+    }
+
+    return failures;
+}
+
+int ch_sample() {
+    int failures = 0;
+
+    struct edge edges[RANDOM_EDGE_LEN];
+    random_edges(edges, RANDOM_EDGE_LEN, true);
+
+    struct graph graph = {0};
+    graph_init_edges(&graph, true, RANDOM_VERTEX_LEN, GRAPH_STORAGE_CSR, edges, RANDOM_EDGE_LEN);
+
+    struct gch ch = {0};
+    if (!gch_init(&ch, &graph)) {
+        printf("ch_init failed\n");
+        graph_destroy(&graph);
+        return 1;
+    }
+
+    for (vertex_t s = 0; s < RANDOM_VERTEX_LEN; s += 7) {
+        struct sssp_tree tree = {0};
+        graph_sssp(&graph, s, VERTEX_T_MAX, &tree);
+
+        for (vertex_t t = 0; t < RANDOM_VERTEX_LEN; t++) {
+            distance_t distance = gch_distance(&ch, s, t);
+            if (distance != sssp_tree_distance(&tree, t)) {
+                printf("ch_distance(%" VERTEX_PRI ", %" VERTEX_PRI ") differs\n", s, t);
+                failures++;
+                continue;
+            }
+
+            struct path path = {0};
+            if (!gch_path(&ch, s, t, &path)) {
+                failures += distance != DISTANCE_MAX;
+                continue;
+            }
+
+            // the shortcuts must be unpacked into edges
+            struct vertex_array* vertices = &path.vertices;
+            distance_t sum = 0;
+
+            for (size_t k = 1; k < vertices->len; k++) {
+                if (!graph_has(&graph, vertices->data[k - 1], vertices->data[k])) {
+                    sum = DISTANCE_MAX;
+                    break;
+                }
+
+                sum += graph_get(&graph, vertices->data[k - 1], vertices->data[k]);
+            }
+
+            if (vertices->data[0] != s || vertices->data[vertices->len - 1] != t || sum != distance
+                || path.weight != distance) {
+                printf("ch_path(%" VERTEX_PRI ", %" VERTEX_PRI ") differs\n", s, t);
+                failures++;
+            }
+
+            path_destroy(&path);
+        }
+
+        sssp_tree_destroy(&tree);
+    }
+
+    gch_destroy(&ch);
+    graph_destroy(&graph);
+
+    return failures;
+}
+
+static bool pll_load_bytes(const char* bytes, size_t size) {
+    FILE* file = tmpfile();
+    if (file == NULL) {
+        return false;
+    }
+
+    struct gpll pll = {0};
+    bool loaded = fwrite(bytes, 1, size, file) == size && fseek(file, 0, SEEK_SET) == 0 && gpll_load(&pll, file);
+
+    gpll_destroy(&pll);
+    fclose(file);
+
+    return loaded;
+}
+
+int pll_sample() {
+    int failures = 0;
+
+    struct edge edges[RANDOM_EDGE_LEN];
+    random_edges(edges, RANDOM_EDGE_LEN, false);
+
+    struct graph graph = {0};
+    graph_init_edges(&graph, false, RANDOM_VERTEX_LEN, GRAPH_STORAGE_BITSET, edges, RANDOM_EDGE_LEN);
+
+    struct gpll built = {0};
+    if (!gpll_init(&built, &graph)) {
+        printf("pll_init failed\n");
+        graph_destroy(&graph);
+        return 1;
+    }
+
+    // the labels must be the same after a round trip
+    struct gpll loaded = {0};
+    FILE* file = tmpfile();
+
+    if (file == NULL || !gpll_save(&built, file) || fseek(file, 0, SEEK_SET) != 0 || !gpll_load(&loaded, file)) {
+        printf("pll_save/load failed\n");
+        failures++;
+    }
+
+    // a corrupted file must be rejected instead of being read
+    long size = file != NULL && fseek(file, 0, SEEK_END) == 0 ? ftell(file) : -1;
+    char* bytes = size > 0 ? malloc((size_t) size) : NULL;
+
+    if (bytes != NULL && fseek(file, 0, SEEK_SET) == 0 && fread(bytes, 1, (size_t) size, file) == (size_t) size) {
+        size_t label_len = built.offsets[built.len];
+        // the last offset is just before the hubs and the hops
+        size_t last_offset = (size_t) size - label_len * (sizeof(vertex_t) + sizeof(uint32_t)) - sizeof(size_t);
+
+        if (!pll_load_bytes(bytes, (size_t) size)) {
+            printf("pll_load(bytes) failed\n");
+            failures++;
+        }
+        if (pll_load_bytes(bytes, (size_t) size - 1)) {
+            printf("pll_load(truncated) differs\n");
+            failures++;
+        }
+
+        // the byte order marker follows the magic bytes
+        bytes[8] ^= 0x7F;
+        if (pll_load_bytes(bytes, (size_t) size)) {
+            printf("pll_load(byte order) differs\n");
+            failures++;
+        }
+        bytes[8] ^= 0x7F;
+
+        bytes[last_offset] ^= 1;
+        if (pll_load_bytes(bytes, (size_t) size)) {
+            printf("pll_load(last offset) differs\n");
+            failures++;
+        }
+    } else {
+        printf("pll_save(bytes) failed\n");
+        failures++;
+    }
+
+    free(bytes);
+
+    if (file != NULL) {
+        fclose(file);
+    }
+
+    for (vertex_t s = 0; s < RANDOM_VERTEX_LEN; s++) {
+        // the unweighted edges weigh 1, so the distances are
+        // the hops
+        struct sssp_tree tree = {0};
+        graph_sssp(&graph, s, VERTEX_T_MAX, &tree);
+
+        for (vertex_t t = 0; t < RANDOM_VERTEX_LEN; t++) {
+            distance_t distance = sssp_tree_distance(&tree, t);
+            size_t hops = distance == DISTANCE_MAX ? SIZE_MAX : (size_t) distance;
+
+            if (gpll_hops(&built, s, t) != hops || gpll_hops(&loaded, s, t) != hops) {
+                printf("pll_hops(%" VERTEX_PRI ", %" VERTEX_PRI ") differs\n", s, t);
+                failures++;
+            }
+        }
+
+        sssp_tree_destroy(&tree);
+    }
+
+    gpll_destroy(&built);
+    gpll_destroy(&loaded);
+    graph_destroy(&graph);
+
+    return failures;
+}
+
+int delta_sample() {
+    int failures = 0;
+
+    struct edge edges[RANDOM_EDGE_LEN];
+    random_edges(edges, RANDOM_EDGE_LEN, true);
+
+    struct graph graph = {0};
+    graph_init_edges(&graph, true, RANDOM_VERTEX_LEN, GRAPH_STORAGE_CSR, edges, RANDOM_EDGE_LEN);
+
+    // several widths, so there are light and heavy edges
+    const distance_t deltas[] = {0, 1, 3};
+    const size_t threads[] = {1, 3, 8};
+
+    for (vertex_t s = 0; s < RANDOM_VERTEX_LEN; s += 5) {
+        struct sssp_tree expected = {0};
+        graph_sssp(&graph, s, VERTEX_T_MAX, &expected);
+
+        for (size_t d = 0; d < sizeof(deltas) / sizeof(deltas[0]); d++) {
+            for (size_t k = 0; k < sizeof(threads) / sizeof(threads[0]); k++) {
+                struct sssp_tree tree = {0};
+                graph_sssp_delta(&graph, s, VERTEX_T_MAX, deltas[d], threads[k], &tree);
+
+                // the ties must pick the same parents as well
+                if (tree.len != expected.len
+                    || memcmp(tree.distances, expected.distances, sizeof(distance_t) * tree.len) != 0
+                    || memcmp(tree.parents, expected.parents, sizeof(vertex_t) * tree.len) != 0) {
+                    printf("sssp_delta(%" VERTEX_PRI ") differs\n", s);
+                    failures++;
+                }
+
+                sssp_tree_destroy(&tree);
+            }
+        }
+
+        // the early stop must keep the same vertices as
+        // graph_sssp, up to the distance of the target
+        vertex_t end = (s * 7 + 3) % RANDOM_VERTEX_LEN;
+
+        struct sssp_tree tree = {0};
+        struct sssp_tree stopped = {0};
+        graph_sssp_delta(&graph, s, end, 2, 4, &tree);
+        graph_sssp(&graph, s, end, &stopped);
+
+        if (tree.len != stopped.len
+            || memcmp(tree.distances, stopped.distances, sizeof(distance_t) * tree.len) != 0
+            || memcmp(tree.parents, stopped.parents, sizeof(vertex_t) * tree.len) != 0) {
+            printf("sssp_delta(%" VERTEX_PRI ", %" VERTEX_PRI ") early stop differs\n", s, end);
+            failures++;
+        }
+
+        // and so the paths of both searches, with and without
+        // a destination vertex
+        const vertex_t ends[] = {VERTEX_T_MAX, end};
+
+        for (size_t e = 0; e < sizeof(ends) / sizeof(ends[0]); e++) {
+            u32path_map delta_paths = {0};
+            u32path_map dijkstra_paths = {0};
+            graph_minimal_path_mode(&graph, s, ends[e], GRAPH_PATH_DELTA_STEPPING, &delta_paths);
+            graph_minimal_path_mode(&graph, s, ends[e], GRAPH_PATH_DIJKSTRA, &dijkstra_paths);
+
+            for (vertex_t t = 0; t < RANDOM_VERTEX_LEN; t++) {
+                struct path* delta_path = hashmap_get(&delta_paths, t);
+                struct path* dijkstra_path = hashmap_get(&dijkstra_paths, t);
+
+                if ((delta_path == NULL) != (dijkstra_path == NULL)
+                    || (delta_path != NULL
+                        && (delta_path->weight != dijkstra_path->weight
+                            || delta_path->vertices.len != dijkstra_path->vertices.len
+                            || memcmp(delta_path->vertices.data,
+                                      dijkstra_path->vertices.data,
+                                      sizeof(vertex_t) * delta_path->vertices.len)
+                                   != 0))) {
+                    printf("delta minimal_path(%" VERTEX_PRI ", %" VERTEX_PRI ") differs\n", s, t);
+                    failures++;
+                }
+            }
+
+            hashmap_destroy(&delta_paths);
+            hashmap_destroy(&dijkstra_paths);
+        }
+
+        sssp_tree_destroy(&tree);
+        sssp_tree_destroy(&stopped);
+        sssp_tree_destroy(&expected);
+    }
+
+    graph_destroy(&graph);
+
+    // the ties of zero weight edges, every vertex is at the
+    // same distance, so the fewest zero edges and then the
+    // lowest parent wins
+    const struct edge ties[] = {
+        {0, 5, 1}, {0, 4, 1}, {5, 3, 0}, {4, 3, 0}, {3, 2, 0}, {5, 2, 0}, {4, 1, 0}, {1, 2, 0},
+    };
+    graph_init_edges(&graph, true, 6, GRAPH_STORAGE_CSR, ties, sizeof(ties) / sizeof(ties[0]));
+
+    for (size_t k = 0; k < sizeof(threads) / sizeof(threads[0]); k++) {
+        struct sssp_tree expected = {0};
+        struct sssp_tree tree = {0};
+        graph_sssp(&graph, 0, VERTEX_T_MAX, &expected);
+        graph_sssp_delta(&graph, 0, VERTEX_T_MAX, 0, threads[k], &tree);
+
+        if (expected.len != 6 || tree.len != 6 || expected.parents[1] != 4 || expected.parents[2] != 5
+            || expected.parents[3] != 4
+            || memcmp(tree.parents, expected.parents, sizeof(vertex_t) * tree.len) != 0) {
+            printf("sssp_delta zero weight ties differs\n");
+            failures++;
+        }
+
+        sssp_tree_destroy(&expected);
+        sssp_tree_destroy(&tree);
+    }
+
+    // a removed vertex has no tree, such as graph_sssp
+    graph_remove_vertex(&graph, 4);
+
+    struct sssp_tree removed = {0};
+    struct sssp_tree removed_delta = {0};
+    graph_sssp(&graph, 4, VERTEX_T_MAX, &removed);
+    graph_sssp_delta(&graph, 4, VERTEX_T_MAX, 0, 2, &removed_delta);
+
+    if (removed.len != 0 || removed_delta.len != 0) {
+        printf("sssp_delta removed vertex differs\n");
+        failures++;
+    }
+
+    sssp_tree_destroy(&removed);
+    sssp_tree_destroy(&removed_delta);
+
+    graph_destroy(&graph);
+
+    return failures;
+}
+
+int dial_sample() {
+    int failures = 0;
+
+#if !WEIGHT_FLOAT && WEIGHT_BITS == 8
+    // the weights can't be heavier than the bucket queue takes
+    return failures;
+#else
+
+    struct edge edges[RANDOM_EDGE_LEN];
+    random_edges(edges, RANDOM_EDGE_LEN, true);
+
+    struct graph small = {0};
+    graph_init_edges(&small, true, RANDOM_VERTEX_LEN, GRAPH_STORAGE_CSR, edges, RANDOM_EDGE_LEN);
+
+    // the same edges, but too heavy for the bucket queue
+    for (size_t k = 0; k < RANDOM_EDGE_LEN; k++) {
+        if (edges[k].weight != NONE_WEIGHT_VALUE) {
+            edges[k].weight *= GRAPH_DIAL_MAX_WEIGHT / 8;
+        }
+    }
+
+    struct graph heavy = {0};
+    graph_init_edges(&heavy, true, RANDOM_VERTEX_LEN, GRAPH_STORAGE_CSR, edges, RANDOM_EDGE_LEN);
+
+    if (small.max_weight > GRAPH_DIAL_MAX_WEIGHT || heavy.max_weight <= GRAPH_DIAL_MAX_WEIGHT) {
+        printf("max_weight differs\n");
+        failures++;
+    }
+
+    for (vertex_t s = 0; s < RANDOM_VERTEX_LEN; s += 3) {
+        struct sssp_tree a = {0};
+        struct sssp_tree b = {0};
+        graph_sssp(&small, s, VERTEX_T_MAX, &a);
+        graph_sssp(&heavy, s, VERTEX_T_MAX, &b);
+
+        for (vertex_t t = 0; t < RANDOM_VERTEX_LEN; t++) {
+            distance_t distance = sssp_tree_distance(&a, t);
+            distance_t expected = sssp_tree_distance(&b, t);
+
+            if (distance == DISTANCE_MAX ? expected != DISTANCE_MAX
+                                         : distance * (GRAPH_DIAL_MAX_WEIGHT / 8) != expected) {
+                printf("sssp dial(%" VERTEX_PRI ", %" VERTEX_PRI ") differs\n", s, t);
+                failures++;
+            }
+        }
+
+        sssp_tree_destroy(&a);
+        sssp_tree_destroy(&b);
+    }
+
+    graph_destroy(&small);
+    graph_destroy(&heavy);
+
+    return failures;
+#endif
+}
+
+int nearest_sample() {
+    int failures = 0;
+
+    struct edge edges[RANDOM_EDGE_LEN];
+    random_edges(edges, RANDOM_EDGE_LEN, true);
+
+    struct graph graph = {0};
+    graph_init_edges(&graph, true, RANDOM_VERTEX_LEN, GRAPH_STORAGE_CSR, edges, RANDOM_EDGE_LEN);
+
+    struct gnearest nearest[RANDOM_VERTEX_LEN];
+    const size_t ks[] = {1, 5, 40, RANDOM_VERTEX_LEN};
+
+    for (vertex_t s = 0; s < RANDOM_VERTEX_LEN; s += 4) {
+        struct sssp_tree tree = {0};
+        graph_sssp(&graph, s, VERTEX_T_MAX, &tree);
+
+        size_t reachable = 0;
+        for (vertex_t t = 0; t < RANDOM_VERTEX_LEN; t++) {
+            reachable += t != s && sssp_tree_distance(&tree, t) != DISTANCE_MAX;
+        }
+
+        for (size_t q = 0; q < sizeof(ks) / sizeof(ks[0]); q++) {
+            size_t k = ks[q];
+            size_t len = graph_nearest_k(&graph, s, k, nearest);
+
+            if (len != (k < reachable ? k : reachable)) {
+                printf("nearest_k(%" VERTEX_PRI ", %zu) length differs\n", s, k);
+                failures++;
+                continue;
+            }
+
+            // the found vertices are sorted and the others can't
+            // be closer than the last one
+            bool found[RANDOM_VERTEX_LEN] = {0};
+            distance_t last = 0;
+
+            for (size_t n = 0; n < len; n++) {
+                vertex_t t = nearest[n].vertex;
+
+                if (t == s || found[t] || nearest[n].distance < last
+                    || nearest[n].distance != sssp_tree_distance(&tree, t)) {
+                    printf("nearest_k(%" VERTEX_PRI ", %zu)[%zu] differs\n", s, k, n);
+                    failures++;
+                }
+
+                found[t] = true;
+                last = nearest[n].distance;
+            }
+
+            for (vertex_t t = 0; len > 0 && t < RANDOM_VERTEX_LEN; t++) {
+                if (t != s && !found[t] && sssp_tree_distance(&tree, t) < last) {
+                    printf("nearest_k(%" VERTEX_PRI ", %zu) misses %" VERTEX_PRI "\n", s, k, t);
+                    failures++;
+                }
+            }
+        }
+
+        sssp_tree_destroy(&tree);
+    }
+
+    graph_destroy(&graph);
+
+    return failures;
+}
+
+/**
+ * Compare the vertices found by a bounded search with the ones
+ * of a tree up to a bound.
+ */
+static int compare_ball(const struct gnearest_array* ball, const struct sssp_tree* tree, distance_t bound) {
+    int failures = 0;
+
+    bool found[RANDOM_VERTEX_LEN] = {0};
+    distance_t last = 0;
+
+    for (size_t n = 0; n < ball->len; n++) {
+        vertex_t t = ball->data[n].vertex;
+
+        if (t == tree->source || found[t] || ball->data[n].distance < last
+            || ball->data[n].distance != sssp_tree_distance(tree, t)) {
+            printf("ball(%" VERTEX_PRI ")[%zu] differs\n", tree->source, n);
+            failures++;
+        }
+
+        found[t] = true;
+        last = ball->data[n].distance;
+    }
+
+    for (vertex_t t = 0; t < RANDOM_VERTEX_LEN; t++) {
+        distance_t distance = sssp_tree_distance(tree, t);
+        if (t != tree->source && !found[t] && distance != DISTANCE_MAX && distance <= bound) {
+            printf("ball(%" VERTEX_PRI ") misses %" VERTEX_PRI "\n", tree->source, t);
+            failures++;
+        }
+    }
+
+    return failures;
+}
+
+int bounded_sample() {
+    int failures = 0;
+
+    struct edge edges[RANDOM_EDGE_LEN];
+    random_edges(edges, RANDOM_EDGE_LEN, true);
+
+    struct graph weighted = {0};
+    graph_init_edges(&weighted, true, RANDOM_VERTEX_LEN, GRAPH_STORAGE_CSR, edges, RANDOM_EDGE_LEN);
+
+    struct graph unweighted = {0};
+    graph_init_edges(&unweighted, false, RANDOM_VERTEX_LEN, GRAPH_STORAGE_INDEXED, edges, RANDOM_EDGE_LEN);
+
+    const distance_t budgets[] = {0, 5, 12, DISTANCE_MAX};
+    const size_t depths[] = {0, 1, 3, SIZE_MAX};
+
+    for (vertex_t s = 0; s < RANDOM_VERTEX_LEN; s += 6) {
+        struct sssp_tree tree = {0};
+        graph_sssp(&weighted, s, VERTEX_T_MAX, &tree);
+
+        for (size_t b = 0; b < sizeof(budgets) / sizeof(budgets[0]); b++) {
+            struct gnearest_array ball = {0};
+            if (!graph_minimal_path_bounded(&weighted, s, budgets[b], &ball)) {
+                printf("minimal_path_bounded(%" VERTEX_PRI ") failed\n", s);
+                failures++;
+            }
+
+            failures += compare_ball(&ball, &tree, budgets[b]);
+            gnearest_array_destroy(&ball);
+        }
+
+        sssp_tree_destroy(&tree);
+
+        // the unweighted edges weigh 1, so the distances are
+        // the hops
+        graph_sssp(&unweighted, s, VERTEX_T_MAX, &tree);
+
+        for (size_t d = 0; d < sizeof(depths) / sizeof(depths[0]); d++) {
+            struct gnearest_array ball = {0};
+            if (!graph_wave_bounded(&unweighted, s, depths[d], &ball)) {
+                printf("wave_bounded(%" VERTEX_PRI ") failed\n", s);
+                failures++;
+            }
+
+            distance_t bound = depths[d] == SIZE_MAX ? DISTANCE_MAX : (distance_t) depths[d];
+            failures += compare_ball(&ball, &tree, bound);
+            gnearest_array_destroy(&ball);
+        }
+
+        sssp_tree_destroy(&tree);
+    }
+
+    graph_destroy(&weighted);
+    graph_destroy(&unweighted);
+
+    return failures;
+}
+
+int dag_sample() {
+    int failures = 0;
+
+    struct edge edges[RANDOM_EDGE_LEN];
+    random_edges(edges, RANDOM_EDGE_LEN, false);
+
+    struct graph graph = {0};
+    graph_init_edges(&graph, false, RANDOM_VERTEX_LEN, GRAPH_STORAGE_CSR, edges, RANDOM_EDGE_LEN);
+
+    for (vertex_t s = 0; s < RANDOM_VERTEX_LEN; s += 5) {
+        struct sssp_tree tree = {0};
+        graph_sssp(&graph, s, VERTEX_T_MAX, &tree);
+
+        struct bfs_dag dag = {0};
+        graph_bfs_dag(&graph, s, VERTEX_T_MAX, &dag);
+
+        for (vertex_t t = 0; t < RANDOM_VERTEX_LEN; t++) {
+            distance_t distance = sssp_tree_distance(&tree, t);
+            vertex_t hops = bfs_dag_hops(&dag, t);
+
+            if (distance == DISTANCE_MAX ? hops != VERTEX_T_MAX : (distance_t) hops != distance) {
+                printf("bfs_dag(%" VERTEX_PRI ", %" VERTEX_PRI ") differs\n", s, t);
+                failures++;
+                continue;
+            }
+
+            // every neighbor one layer closer is a parent
+            size_t len = 0;
+            const vertex_t* parents = bfs_dag_parents(&dag, t, &len);
+
+            size_t expected = 0;
+            for (vertex_t i = 0; hops != VERTEX_T_MAX && i < RANDOM_VERTEX_LEN; i++) {
+                expected += graph_has(&graph, i, t) && bfs_dag_hops(&dag, i) + 1 == hops;
+            }
+
+            for (size_t k = 0; k < len; k++) {
+                if (!graph_has(&graph, parents[k], t) || bfs_dag_hops(&dag, parents[k]) + 1 != hops) {
+                    expected = SIZE_MAX;
+                }
+            }
+
+            if (len != expected) {
+                printf("bfs_dag parents(%" VERTEX_PRI ", %" VERTEX_PRI ") differs\n", s, t);
+                failures++;
+            }
+        }
+
+        bfs_dag_destroy(&dag);
+        sssp_tree_destroy(&tree);
+    }
+
+    graph_destroy(&graph);
+
+    // a grid has C(2n - 2, n - 1) shortest paths between opposite
+    // corners
+    const vertex_t side = 7;
+    graph_init(&graph, false, side * side);
+
+    for (vertex_t r = 0; r < side; r++) {
+        for (vertex_t c = 0; c < side; c++) {
+            if (c + 1 < side) {
+                graph_add(&graph, r * side + c, r * side + c + 1);
+            }
+            if (r + 1 < side) {
+                graph_add(&graph, r * side + c, (r + 1) * side + c);
+            }
+        }
+    }
+
+    u32vertices_map paths = {0};
+    graph_short_path(&graph, 0, side * side - 1, &paths);
+
+    if (hashmap_size(&paths) != 924) {
+        printf("short_path grid length differs\n");
+        failures++;
+    }
+
+    struct hashmap_iterator it = {0};
+    hashmap_iterator_init(&it, &paths);
+
+    for (struct map_entry entry; hashmap_iterator_next(&it, &entry);) {
+        struct vertex_array* vertices = entry.value;
+
+        bool valid = vertices->len == 2 * side - 1 && vertices->data[0] == 0
+            && vertices->data[vertices->len - 1] == side * side - 1;
+
+        for (size_t k = 1; valid && k < vertices->len; k++) {
+            valid = graph_has(&graph, vertices->data[k - 1], vertices->data[k]);
+        }
+
+        if (!valid) {
+            printf("short_path grid (%" PRIu64 ") differs\n", entry.key);
+            failures++;
+        }
+    }
+
+    hashmap_destroy(&paths);
+    graph_destroy(&graph);
+
+    return failures;
+}
+
+int count_sample() {
+    int failures = 0;
+
+    struct edge edges[RANDOM_EDGE_LEN];
+    random_edges(edges, RANDOM_EDGE_LEN, false);
+
+    struct graph graph = {0};
+    graph_init_edges(&graph, false, RANDOM_VERTEX_LEN, GRAPH_STORAGE_BITSET, edges, RANDOM_EDGE_LEN);
+
+    for (vertex_t s = 0; s < RANDOM_VERTEX_LEN; s += 11) {
+        for (vertex_t t = 0; t < RANDOM_VERTEX_LEN; t += 7) {
+            u32vertices_map paths = {0};
+            graph_short_path(&graph, s, t, &paths);
+
+            if (graph_short_path_count(&graph, s, t) != hashmap_size(&paths)) {
+                printf("short_path_count(%" VERTEX_PRI ", %" VERTEX_PRI ") differs\n", s, t);
+                failures++;
+            }
+
+            hashmap_destroy(&paths);
+        }
+    }
+
+    graph_destroy(&graph);
+
+    // a chain of n diamonds has 2^n shortest paths, so it
+    // saturates after 63 of them
+    const vertex_t diamonds = 70;
+    graph_init(&graph, false, 3 * diamonds + 1);
+
+    for (vertex_t d = 0; d < diamonds; d++) {
+        vertex_t joint = 3 * d;
+
+        graph_add(&graph, joint, joint + 1);
+        graph_add(&graph, joint, joint + 2);
+        graph_add(&graph, joint + 1, joint + 3);
+        graph_add(&graph, joint + 2, joint + 3);
+    }
+
+    if (graph_short_path_count(&graph, 0, 3 * 63) != UINT64_C(1) << 63
+        || graph_short_path_count(&graph, 0, 3 * 64) != UINT64_MAX
+        || graph_short_path_count(&graph, 0, 3 * diamonds) != UINT64_MAX) {
+        printf("short_path_count doesn't saturate\n");
+        failures++;
+    }
+
+    graph_destroy(&graph);
+
+    return failures;
+}
+
+int iter_sample() {
+    int failures = 0;
+
+    struct edge edges[RANDOM_EDGE_LEN];
+    random_edges(edges, RANDOM_EDGE_LEN, false);
+
+    struct graph graph = {0};
+    graph_init_edges(&graph, false, RANDOM_VERTEX_LEN, GRAPH_STORAGE_INDEXED, edges, RANDOM_EDGE_LEN);
+
+    vertex_t buffer[RANDOM_VERTEX_LEN];
+
+    for (vertex_t s = 0; s < RANDOM_VERTEX_LEN; s += 13) {
+        for (vertex_t t = 0; t < RANDOM_VERTEX_LEN; t += 9) {
+            u32vertices_map paths = {0};
+            graph_short_path(&graph, s, t, &paths);
+
+            struct short_path_iter it = {0};
+            if (!short_path_iter_init(&it, &graph, s, t)) {
+                printf("short_path_iter(%" VERTEX_PRI ", %" VERTEX_PRI ") failed\n", s, t);
+                failures++;
+                hashmap_destroy(&paths);
+                continue;
+            }
+
+            // the paths come in the order of the keys, and a
+            // buffer too small keeps the path for the next call
+            mkey_t key = 0;
+            for (size_t len = 0; (len = short_path_iter_next(&it, buffer, 1)) > 0; key++) {
+                struct vertex_array* vertices = hashmap_get(&paths, key);
+
+                if (len == 1 || short_path_iter_next(&it, buffer, len) != len || vertices == NULL
+                    || vertices->len != len || memcmp(vertices->data, buffer, sizeof(vertex_t) * len) != 0) {
+                    printf("short_path_iter(%" VERTEX_PRI ", %" VERTEX_PRI ")[%" PRIu64 "] differs\n", s, t, key);
+                    failures++;
+                    break;
+                }
+            }
+
+            if (key != hashmap_size(&paths)) {
+                printf("short_path_iter(%" VERTEX_PRI ", %" VERTEX_PRI ") length differs\n", s, t);
+                failures++;
+            }
+
+            short_path_iter_destroy(&it);
+            hashmap_destroy(&paths);
+        }
+    }
+
+    graph_destroy(&graph);
+
+    return failures;
+}
+
+int wave_sample() {
+    int failures = 0;
+
+    struct edge edges[RANDOM_EDGE_LEN];
+    random_edges(edges, RANDOM_EDGE_LEN, false);
+
+    struct graph graph = {0};
+    graph_init_edges(&graph, false, RANDOM_VERTEX_LEN, GRAPH_STORAGE_CSR, edges, RANDOM_EDGE_LEN);
+
+    for (vertex_t s = 0; s < RANDOM_VERTEX_LEN; s += 10) {
+        struct bfs_dag dag = {0};
+        graph_bfs_dag(&graph, s, VERTEX_T_MAX, &dag);
+
+        size_t reachable = 0;
+        for (vertex_t t = 0; t < RANDOM_VERTEX_LEN; t++) {
+            reachable += bfs_dag_hops(&dag, t) != VERTEX_T_MAX;
+        }
+
+        struct wave wave = {0};
+        graph_wave(&graph, s, VERTEX_T_MAX, false, &wave);
+
+        u32path_map paths = {0};
+        wave_to_path(&wave, &paths);
+
+        // every reached vertex is once in the wave, by a
+        // shortest path
+        if (wave.len != reachable || hashmap_size(&paths) + 1 != reachable) {
+            printf("wave(%" VERTEX_PRI ") length differs\n", s);
+            failures++;
+        }
+
+        struct hashmap_iterator it = {0};
+        hashmap_iterator_init(&it, &paths);
+
+        for (struct map_entry entry; hashmap_iterator_next(&it, &entry);) {
+            struct vertex_array* vertices = &((struct path*) entry.value)->vertices;
+            vertex_t t = vertices->data[vertices->len - 1];
+
+            bool valid = vertices->data[0] == s && vertices->len == (size_t) bfs_dag_hops(&dag, t) + 1;
+            for (size_t k = 1; valid && k < vertices->len; k++) {
+                valid = graph_has(&graph, vertices->data[k - 1], vertices->data[k]);
+            }
+
+            if (!valid) {
+                printf("wave(%" VERTEX_PRI ", %" VERTEX_PRI ") differs\n", s, t);
+                failures++;
+            }
+        }
+
+        hashmap_destroy(&paths);
+        wave_destroy(&wave);
+        bfs_dag_destroy(&dag);
+    }
+
+    graph_destroy(&graph);
+
+    // a node with many sub-nodes looks them up in the index, and
+    // adding one again gives the same sub-node
+    struct wave wave = {0};
+    wave_init(&wave, 0);
+
+    size_t first = wave_add(&wave, 0, 1);
+    for (vertex_t v = 2; v < 1000; v++) {
+        wave_add(&wave, wave_add(&wave, 0, v), v);
+    }
+
+    for (vertex_t v = 2; v < 1000; v++) {
+        size_t node = wave_get(&wave, 0, v);
+
+        if (node == WAVE_NONE || wave.nodes[node].vertex != v || wave_add(&wave, 0, v) != node
+            || wave_get(&wave, node, v) == WAVE_NONE || wave_get(&wave, node, v + 1) != WAVE_NONE) {
+            printf("wave_get(%" VERTEX_PRI ") differs\n", v);
+            failures++;
+        }
+    }
+
+    if (wave_get(&wave, 0, 1) != first || wave_get(&wave, 0, 1000) != WAVE_NONE || wave.len != 1 + 1 + 2 * 998) {
+        printf("wave index differs\n");
+        failures++;
+    }
+
+    wave_destroy(&wave);
+
+    return failures;
+}